@@ -0,0 +1,239 @@
+#include "AnalysisClient.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+#if defined(MSG_NOSIGNAL)
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL; ///< A closed daemon socket must not raise SIGPIPE
+#else
+        constexpr int SEND_FLAGS = 0;
+#endif
+
+        /**
+         * @brief Writes the whole buffer, retrying on interruption
+         */
+        bool SendAll(int socket, const void *data, size_t size)
+        {
+            const auto *bytes = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                const ssize_t sent = ::send(socket, bytes, size, SEND_FLAGS);
+                if (sent < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (sent <= 0)
+                {
+                    return false;
+                }
+                bytes += sent;
+                size -= static_cast<size_t>(sent);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Receives the handshake response and the descriptor passed with it
+         * @return False if the response is incomplete
+         */
+        bool ReceiveResponse(int socket, AnalysisResponse &response, int &descriptor)
+        {
+            descriptor = -1;
+
+            iovec data{ &response, sizeof(response) };
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+            msghdr message{};
+            message.msg_iov = &data;
+            message.msg_iovlen = 1;
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+
+            ssize_t received = 0;
+            do
+            {
+                received = ::recvmsg(socket, &message, 0);
+            } while (received < 0 && errno == EINTR);
+
+            for (cmsghdr *entry = CMSG_FIRSTHDR(&message); entry != nullptr; entry = CMSG_NXTHDR(&message, entry))
+            {
+                if (entry->cmsg_level == SOL_SOCKET && entry->cmsg_type == SCM_RIGHTS)
+                {
+                    std::memcpy(&descriptor, CMSG_DATA(entry), sizeof(int));
+                }
+            }
+
+            return received == static_cast<ssize_t>(sizeof(response)) && response.magic == ANALYSIS_PROTOCOL_MAGIC;
+        }
+    } // namespace
+
+    AnalysisClient::AnalysisClient()
+        : socket(-1), region(nullptr), regionSize(0), header(nullptr), audio(nullptr), results(nullptr)
+    {
+    }
+
+    AnalysisClient::~AnalysisClient()
+    {
+        Disconnect();
+    }
+
+    AnalysisStatus AnalysisClient::Connect(const char *socketPath, const AnalysisSessionConfig &config)
+    {
+        Disconnect();
+
+        if (!IsValidAnalysisConfig(config))
+        {
+            return AnalysisStatus::InvalidConfig;
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath == nullptr || std::strlen(socketPath) >= sizeof(address.sun_path))
+        {
+            return AnalysisStatus::ConnectionFailed;
+        }
+        std::strcpy(address.sun_path, socketPath);
+
+        socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket < 0)
+        {
+            return AnalysisStatus::ConnectionFailed;
+        }
+
+        const AnalysisRequest request{ ANALYSIS_PROTOCOL_MAGIC, ANALYSIS_PROTOCOL_VERSION, config };
+        AnalysisResponse response{};
+        int descriptor = -1;
+        if (::connect(socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0
+            || !SendAll(socket, &request, sizeof(request)) || !ReceiveResponse(socket, response, descriptor))
+        {
+            if (descriptor >= 0)
+            {
+                ::close(descriptor);
+            }
+            Disconnect();
+            return AnalysisStatus::ConnectionFailed;
+        }
+
+        if (response.status != AnalysisStatus::Ok || descriptor < 0)
+        {
+            if (descriptor >= 0)
+            {
+                ::close(descriptor);
+            }
+            Disconnect();
+            return response.status != AnalysisStatus::Ok ? response.status : AnalysisStatus::ConnectionFailed;
+        }
+
+        const AnalysisSharedLayout layout = GetAnalysisSharedLayout(config.audioCapacity, config.resultCapacity);
+        void *mapping = response.regionSize >= layout.totalSize
+                            ? ::mmap(nullptr, layout.totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0)
+                            : MAP_FAILED;
+        ::close(descriptor);
+        if (mapping == MAP_FAILED)
+        {
+            Disconnect();
+            return AnalysisStatus::OutOfMemory;
+        }
+
+        region = mapping;
+        regionSize = layout.totalSize;
+        header = static_cast<AnalysisSharedHeader *>(region);
+        if (header->magic != ANALYSIS_PROTOCOL_MAGIC || header->version != ANALYSIS_PROTOCOL_VERSION
+            || header->audioCapacity != config.audioCapacity || header->resultCapacity != config.resultCapacity)
+        {
+            Disconnect();
+            return AnalysisStatus::VersionMismatch;
+        }
+
+        audio = reinterpret_cast<float *>(static_cast<char *>(region) + layout.audioOffset);
+        results = reinterpret_cast<AnalysisResult *>(static_cast<char *>(region) + layout.resultOffset);
+        return AnalysisStatus::Ok;
+    }
+
+    void AnalysisClient::Disconnect()
+    {
+        if (region != nullptr)
+        {
+            ::munmap(region, regionSize);
+        }
+        if (socket >= 0)
+        {
+            ::close(socket);
+        }
+
+        socket = -1;
+        region = nullptr;
+        regionSize = 0;
+        header = nullptr;
+        audio = nullptr;
+        results = nullptr;
+    }
+
+    bool AnalysisClient::IsConnected() const
+    {
+        return header != nullptr;
+    }
+
+    size_t AnalysisClient::PushAudio(std::span<const float> samples)
+    {
+        if (header == nullptr)
+        {
+            return 0;
+        }
+
+        const size_t capacity = header->audioCapacity;
+        const uint64_t write = header->audioWrite.load(std::memory_order_relaxed);
+        const uint64_t read = header->audioRead.load(std::memory_order_acquire);
+        const size_t count = std::min(samples.size(), capacity - static_cast<size_t>(write - read));
+
+        const size_t index = static_cast<size_t>(write) & (capacity - 1);
+        const size_t firstPart = std::min(count, capacity - index);
+        std::copy_n(samples.data(), firstPart, audio + index);
+        std::copy_n(samples.data() + firstPart, count - firstPart, audio);
+        header->audioWrite.store(write + count, std::memory_order_release);
+
+        if (count < samples.size())
+        {
+            header->droppedSamples.fetch_add(samples.size() - count, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    size_t AnalysisClient::ReadResults(std::span<AnalysisResult> output)
+    {
+        if (header == nullptr)
+        {
+            return 0;
+        }
+
+        const size_t capacity = header->resultCapacity;
+        const uint64_t read = header->resultRead.load(std::memory_order_relaxed);
+        const uint64_t write = header->resultWrite.load(std::memory_order_acquire);
+        const size_t count = std::min(output.size(), static_cast<size_t>(write - read));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            output[i] = results[static_cast<size_t>(read + i) & (capacity - 1)];
+        }
+        header->resultRead.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    uint64_t AnalysisClient::GetDroppedSamples() const
+    {
+        return header != nullptr ? header->droppedSamples.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t AnalysisClient::GetDroppedResults() const
+    {
+        return header != nullptr ? header->droppedResults.load(std::memory_order_relaxed) : 0;
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "AnalysisProtocol.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Client side of a guitar-dsp-daemon analysis session
+     *
+     * Connect() performs the handshake over the daemon's Unix-domain socket
+     * and maps the session's shared memory. Afterwards audio goes to the
+     * daemon and results come back through shared SPSC rings only; the
+     * socket stays open solely to tie the session's lifetime to this object.
+     *
+     * One thread may call PushAudio() (typically the audio callback) and
+     * one thread ReadResults(); both are wait-free and make no system calls.
+     */
+    class AnalysisClient
+    {
+    public:
+        AnalysisClient();
+
+        ~AnalysisClient();
+
+        AnalysisClient(const AnalysisClient &) = delete;
+        AnalysisClient &operator=(const AnalysisClient &) = delete;
+        AnalysisClient(AnalysisClient &&) = delete;
+        AnalysisClient &operator=(AnalysisClient &&) = delete;
+
+        /**
+         * @brief Opens a session (closes any previous one first)
+         *
+         * Not real-time safe: blocks on the handshake.
+         *
+         * @param socketPath Daemon control socket
+         * @param config Requested pipeline
+         * @return AnalysisStatus::Ok, or the reason the session was not opened
+         */
+        AnalysisStatus Connect(const char *socketPath, const AnalysisSessionConfig &config = AnalysisSessionConfig{});
+
+        /**
+         * @brief Closes the session and unmaps shared memory
+         */
+        void Disconnect();
+
+        /**
+         * @brief Returns true while a session is open
+         */
+        [[nodiscard]] bool IsConnected() const;
+
+        /**
+         * @brief Appends audio to the session's input ring
+         * @param samples Next block of the input stream
+         * @return Samples accepted; the rest is dropped (and counted) when the ring is full
+         */
+        size_t PushAudio(std::span<const float> samples);
+
+        /**
+         * @brief Takes published results, oldest first
+         * @param output Output entries
+         * @return Number of entries written
+         */
+        size_t ReadResults(std::span<AnalysisResult> output);
+
+        /**
+         * @brief Returns samples dropped because the daemon fell behind
+         */
+        [[nodiscard]] uint64_t GetDroppedSamples() const;
+
+        /**
+         * @brief Returns results dropped because they were not read in time
+         */
+        [[nodiscard]] uint64_t GetDroppedResults() const;
+
+    private:
+        int socket;                   ///< Control connection (-1 when closed)
+        void *region;                 ///< Mapped shared memory
+        size_t regionSize;            ///< Mapped bytes
+        AnalysisSharedHeader *header; ///< Ring counters
+        float *audio;                 ///< Audio ring
+        AnalysisResult *results;      ///< Result ring
+    };
+
+} // namespace GuitarDSP
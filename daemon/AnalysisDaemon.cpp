@@ -0,0 +1,97 @@
+// Standalone analysis daemon.
+//
+// Serves pitch detection to local processes: clients open a session over
+// the control socket (see AnalysisClient.h), stream audio into a shared
+// memory ring and read results back from another, while detectors and
+// stabilizers of all sessions share one worker pool in this process.
+// SIGINT or SIGTERM shuts the daemon down and removes the socket.
+//
+// Usage: guitar-dsp-daemon [--socket <path>] [--threads <n>] [--max-sessions <n>] [--poll-ms <ms>]
+
+#include "AnalysisServer.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace GuitarDSP;
+
+namespace
+{
+    AnalysisServer *activeServer = nullptr; ///< Server stopped by the signal handler
+
+    void HandleSignal(int)
+    {
+        if (activeServer != nullptr)
+        {
+            activeServer->Stop();
+        }
+    }
+
+    bool ParseSettings(int argc, char **argv, AnalysisServerConfig &config)
+    {
+        for (int i = 1; i < argc; i += 2)
+        {
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+
+            const char *value = argv[i + 1];
+            if (std::strcmp(argv[i], "--socket") == 0)
+            {
+                config.socketPath = value;
+            }
+            else if (std::strcmp(argv[i], "--threads") == 0)
+            {
+                config.threadCount = std::strtoul(value, nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--max-sessions") == 0)
+            {
+                config.maxSessions = std::strtoul(value, nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--poll-ms") == 0)
+            {
+                config.pollIntervalMs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    AnalysisServerConfig config;
+    if (!ParseSettings(argc, argv, config))
+    {
+        std::fprintf(stderr,
+            "Usage: %s [--socket <path>] [--threads <n>] [--max-sessions <n>] [--poll-ms <ms>]\n",
+            argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    AnalysisServer server(config);
+    if (!server.Start())
+    {
+        std::fprintf(stderr, "Cannot listen on %s\n", config.socketPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::printf("guitar-dsp-daemon listening on %s\n", config.socketPath.c_str());
+    std::fflush(stdout);
+    server.Run();
+
+    activeServer = nullptr;
+    std::printf("guitar-dsp-daemon stopped\n");
+    return EXIT_SUCCESS;
+}
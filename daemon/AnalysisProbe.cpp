@@ -0,0 +1,186 @@
+// Local end-to-end check of guitar-dsp-daemon.
+//
+// Opens a session, streams a synthetic plucked tone in real-time sized
+// blocks (paced like an audio callback unless --fast is given) and prints
+// every result the daemon publishes, followed by drop counters.
+//
+// Usage: guitar-dsp-daemon-probe [--socket <path>] [--frequency <hz>] [--seconds <s>]
+//        [--detector yin|mpm|hybrid] [--fast 0|1]
+
+#include "AnalysisClient.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GuitarDSP;
+
+namespace
+{
+    /**
+     * @brief Probe settings
+     */
+    struct Settings
+    {
+        std::string socketPath = DEFAULT_ANALYSIS_SOCKET; ///< Daemon control socket
+        float frequency = 110.0f;                         ///< Tone frequency (Hz)
+        float seconds = 2.0f;                             ///< Streamed duration
+        std::string detector = "hybrid";                  ///< yin, mpm or hybrid
+        bool fast = false;                                ///< Stream without real-time pacing
+    };
+
+    constexpr size_t BLOCK_SIZE = 256; ///< Samples per simulated audio callback
+
+    bool ParseSettings(int argc, char **argv, Settings &settings)
+    {
+        for (int i = 1; i < argc; i += 2)
+        {
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+
+            const char *value = argv[i + 1];
+            if (std::strcmp(argv[i], "--socket") == 0)
+            {
+                settings.socketPath = value;
+            }
+            else if (std::strcmp(argv[i], "--frequency") == 0)
+            {
+                settings.frequency = std::strtof(value, nullptr);
+            }
+            else if (std::strcmp(argv[i], "--seconds") == 0)
+            {
+                settings.seconds = std::strtof(value, nullptr);
+            }
+            else if (std::strcmp(argv[i], "--detector") == 0)
+            {
+                settings.detector = value;
+            }
+            else if (std::strcmp(argv[i], "--fast") == 0)
+            {
+                settings.fast = std::strcmp(value, "0") != 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const char *GetStatusName(AnalysisStatus status)
+    {
+        switch (status)
+        {
+        case AnalysisStatus::Ok:
+            return "ok";
+        case AnalysisStatus::ConnectionFailed:
+            return "connection failed";
+        case AnalysisStatus::VersionMismatch:
+            return "protocol version mismatch";
+        case AnalysisStatus::InvalidConfig:
+            return "invalid configuration";
+        case AnalysisStatus::SessionLimit:
+            return "session limit reached";
+        case AnalysisStatus::OutOfMemory:
+            return "shared memory unavailable";
+        default:
+            return "unknown";
+        }
+    }
+
+    void PrintResults(AnalysisClient &client, float sampleRate)
+    {
+        AnalysisResult results[64];
+        while (const size_t count = client.ReadResults(results))
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double time = static_cast<double>(results[i].frameStart) / sampleRate;
+                if (results[i].valid != 0)
+                {
+                    std::printf("%8.3f s  %8.2f Hz  confidence %.2f\n", time, results[i].frequency,
+                        results[i].confidence);
+                }
+                else
+                {
+                    std::printf("%8.3f s  no pitch\n", time);
+                }
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Settings settings;
+    if (!ParseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr,
+            "Usage: %s [--socket <path>] [--frequency <hz>] [--seconds <s>] [--detector yin|mpm|hybrid] "
+            "[--fast 0|1]\n",
+            argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    AnalysisSessionConfig config;
+    if (settings.detector == "yin")
+    {
+        config.detector = AnalysisDetector::Yin;
+    }
+    else if (settings.detector == "mpm")
+    {
+        config.detector = AnalysisDetector::Mpm;
+    }
+
+    AnalysisClient client;
+    const AnalysisStatus status = client.Connect(settings.socketPath.c_str(), config);
+    if (status != AnalysisStatus::Ok)
+    {
+        std::fprintf(stderr, "Cannot open session on %s: %s\n", settings.socketPath.c_str(), GetStatusName(status));
+        return EXIT_FAILURE;
+    }
+
+    const auto totalSamples = static_cast<size_t>(settings.seconds * config.sampleRate);
+    const auto blockPeriod = std::chrono::duration<double>(static_cast<double>(BLOCK_SIZE) / config.sampleRate);
+    const double phaseStep = 2.0 * std::numbers::pi * settings.frequency / config.sampleRate;
+
+    std::vector<float> block(BLOCK_SIZE);
+    auto deadline = std::chrono::steady_clock::now();
+    for (size_t position = 0; position < totalSamples; position += BLOCK_SIZE)
+    {
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            // Plucked string: fundamental plus two decaying harmonics
+            const double n = static_cast<double>(position + i);
+            const double envelope = std::exp(-n / (2.0 * config.sampleRate));
+            block[i] = static_cast<float>(
+                envelope * (0.6 * std::sin(phaseStep * n) + 0.3 * std::sin(2.0 * phaseStep * n)
+                               + 0.1 * std::sin(3.0 * phaseStep * n)));
+        }
+        client.PushAudio(block);
+        PrintResults(client, config.sampleRate);
+
+        if (!settings.fast)
+        {
+            deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(blockPeriod);
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+
+    // Let the daemon finish the last hops
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    PrintResults(client, config.sampleRate);
+
+    std::printf("dropped samples: %llu, dropped results: %llu\n",
+        static_cast<unsigned long long>(client.GetDroppedSamples()),
+        static_cast<unsigned long long>(client.GetDroppedResults()));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace GuitarDSP
+{
+    constexpr uint32_t ANALYSIS_PROTOCOL_MAGIC = 0x50534447;                ///< "GDSP" (little-endian)
+    constexpr uint32_t ANALYSIS_PROTOCOL_VERSION = 1;                       ///< Bumped on any layout change
+    constexpr const char *DEFAULT_ANALYSIS_SOCKET = "/tmp/guitar-dsp.sock"; ///< Default control socket path
+    constexpr size_t ANALYSIS_CACHE_LINE = 64;                              ///< Alignment of shared counters
+    constexpr uint32_t MAX_ANALYSIS_FRAME_SIZE = 16384;                     ///< Largest frame a session may request
+    constexpr uint32_t MAX_ANALYSIS_AUDIO_CAPACITY = 1u << 22;              ///< Largest audio ring (samples, 16 MiB)
+    constexpr uint32_t MAX_ANALYSIS_RESULT_CAPACITY = 1u << 16;             ///< Largest result ring (entries)
+
+    /**
+     * @brief Pitch detector run by a daemon session
+     */
+    enum class AnalysisDetector : uint32_t
+    {
+        Yin,   ///< YinPitchDetector
+        Mpm,   ///< MpmPitchDetector
+        Hybrid ///< HybridPitchDetector
+    };
+
+    /**
+     * @brief Stabilizer applied to a daemon session's results
+     */
+    enum class AnalysisStabilizer : uint32_t
+    {
+        None,   ///< Raw detector results
+        Ema,    ///< ExponentialMovingAverage
+        Median, ///< MedianFilter
+        Hybrid  ///< HybridStabilizer
+    };
+
+    /**
+     * @brief Handshake outcome reported to the client
+     */
+    enum class AnalysisStatus : uint32_t
+    {
+        Ok,               ///< Session open, shared memory attached
+        ConnectionFailed, ///< Daemon not reachable or handshake interrupted (client side)
+        VersionMismatch,  ///< Client and daemon protocol versions differ
+        InvalidConfig,    ///< Session configuration rejected
+        SessionLimit,     ///< Daemon is serving its maximum number of sessions
+        OutOfMemory       ///< Shared memory could not be created or mapped
+    };
+
+    /**
+     * @brief Pipeline configuration requested by a client
+     */
+    struct AnalysisSessionConfig
+    {
+        float sampleRate = 48000.0f;                              ///< Client sample rate (Hz)
+        uint32_t frameSize = 4096;                                ///< Analysis frame (samples)
+        uint32_t hopSize = 512;                                   ///< Samples between frames
+        AnalysisDetector detector = AnalysisDetector::Hybrid;     ///< Detector
+        AnalysisStabilizer stabilizer = AnalysisStabilizer::None; ///< Stabilizer
+        float minFrequency = 80.0f;                               ///< Detector minimum frequency (Hz)
+        float maxFrequency = 1200.0f;                             ///< Detector maximum frequency (Hz)
+        uint32_t audioCapacity = 65536;                           ///< Audio ring size (samples, power of 2)
+        uint32_t resultCapacity = 1024;                           ///< Result ring size (entries, power of 2)
+    };
+
+    /**
+     * @brief One analysed frame published back to the client
+     */
+    struct AnalysisResult
+    {
+        uint64_t frameStart; ///< Stream index of first sample in the frame
+        float frequency;     ///< Detected (or stabilized) frequency (Hz, 0 if none)
+        float confidence;    ///< Detection confidence [0, 1]
+        uint32_t valid;      ///< Non-zero if a pitch was detected
+        uint32_t reserved;   ///< Padding (zero)
+    };
+
+    /**
+     * @brief Handshake request sent by the client after connecting
+     */
+    struct AnalysisRequest
+    {
+        uint32_t magic;               ///< ANALYSIS_PROTOCOL_MAGIC
+        uint32_t version;             ///< ANALYSIS_PROTOCOL_VERSION
+        AnalysisSessionConfig config; ///< Requested pipeline
+    };
+
+    /**
+     * @brief Handshake reply; on success it carries the shared memory descriptor (SCM_RIGHTS)
+     */
+    struct AnalysisResponse
+    {
+        uint32_t magic;        ///< ANALYSIS_PROTOCOL_MAGIC
+        AnalysisStatus status; ///< Handshake outcome
+        uint64_t regionSize;   ///< Bytes to map from the passed descriptor
+    };
+
+    /**
+     * @brief Header at the start of a session's shared memory region
+     *
+     * Followed by the audio ring (audioCapacity floats) and the result ring
+     * (resultCapacity AnalysisResult entries). Both rings are SPSC with
+     * free-running 64-bit counters; each counter is written by one side
+     * only and sits on its own cache line.
+     *
+     * Audio: client writes samples and advances audioWrite; daemon consumes
+     * and advances audioRead. Results: daemon writes and advances
+     * resultWrite; client reads and advances resultRead.
+     */
+    struct AnalysisSharedHeader
+    {
+        uint32_t magic;          ///< ANALYSIS_PROTOCOL_MAGIC
+        uint32_t version;        ///< ANALYSIS_PROTOCOL_VERSION
+        uint32_t audioCapacity;  ///< Audio ring size (samples)
+        uint32_t resultCapacity; ///< Result ring size (entries)
+
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> audioWrite;     ///< Samples written (client)
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> audioRead;      ///< Samples consumed (daemon)
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> resultWrite;    ///< Results written (daemon)
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> resultRead;     ///< Results consumed (client)
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> droppedSamples; ///< Samples rejected on a full ring (client)
+        alignas(ANALYSIS_CACHE_LINE) std::atomic<uint64_t> droppedResults; ///< Results lost on a full ring (daemon)
+    };
+
+    // Shared between processes: counters must be address-free and the messages plain bytes
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+    static_assert(std::is_trivially_copyable_v<AnalysisRequest>);
+    static_assert(std::is_trivially_copyable_v<AnalysisResponse>);
+    static_assert(std::is_trivially_copyable_v<AnalysisResult>);
+
+    /**
+     * @brief Byte offsets of the rings inside a session's shared memory region
+     */
+    struct AnalysisSharedLayout
+    {
+        size_t audioOffset;  ///< Offset of the audio ring
+        size_t resultOffset; ///< Offset of the result ring
+        size_t totalSize;    ///< Region size
+    };
+
+    /**
+     * @brief Computes the shared memory layout for given ring sizes
+     */
+    constexpr AnalysisSharedLayout GetAnalysisSharedLayout(uint32_t audioCapacity, uint32_t resultCapacity)
+    {
+        const auto alignUp = [](size_t value) {
+            return (value + ANALYSIS_CACHE_LINE - 1) / ANALYSIS_CACHE_LINE * ANALYSIS_CACHE_LINE;
+        };
+
+        const size_t audioOffset = alignUp(sizeof(AnalysisSharedHeader));
+        const size_t resultOffset = alignUp(audioOffset + sizeof(float) * audioCapacity);
+        const size_t totalSize = alignUp(resultOffset + sizeof(AnalysisResult) * resultCapacity);
+        return AnalysisSharedLayout{ audioOffset, resultOffset, totalSize };
+    }
+
+    /**
+     * @brief Returns true if the daemon can run config
+     */
+    constexpr bool IsValidAnalysisConfig(const AnalysisSessionConfig &config)
+    {
+        const auto isPowerOfTwo = [](uint32_t value) { return value != 0 && (value & (value - 1)) == 0; };
+
+        // Upper bounds keep a single handshake from exhausting daemon memory
+        return config.sampleRate > 0.0f && config.hopSize > 0 && config.frameSize >= config.hopSize
+               && config.frameSize <= MAX_ANALYSIS_FRAME_SIZE && config.minFrequency > 0.0f
+               && config.maxFrequency > config.minFrequency && isPowerOfTwo(config.audioCapacity)
+               && isPowerOfTwo(config.resultCapacity) && config.audioCapacity <= MAX_ANALYSIS_AUDIO_CAPACITY
+               && config.resultCapacity <= MAX_ANALYSIS_RESULT_CAPACITY
+               && config.audioCapacity >= config.hopSize && config.detector <= AnalysisDetector::Hybrid
+               && config.stabilizer <= AnalysisStabilizer::Hybrid;
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,578 @@
+#include "AnalysisServer.h"
+#include "HybridPitchDetector.h"
+#include "MpmPitchDetector.h"
+#include "PitchStabilizer.h"
+#include "YinPitchDetector.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <optional>
+#include <poll.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+#if defined(MSG_NOSIGNAL)
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL; ///< A vanished client must not raise SIGPIPE
+#else
+        constexpr int SEND_FLAGS = 0;
+#endif
+        constexpr int LISTEN_BACKLOG = 16; ///< Pending connections queued by the kernel
+
+        std::atomic<uint64_t> regionCounter{ 0 }; ///< Makes shared memory names unique within the process
+
+        /**
+         * @brief Removes a socket file left by a crashed daemon
+         *
+         * Probes the path with connect(): only a socket file refusing the
+         * connection (nobody listening) or a missing file is safe to unlink.
+         *
+         * @param address Control socket address
+         * @return False if the path is in use or could not be probed
+         */
+        bool RemoveStaleSocket(const sockaddr_un &address)
+        {
+            // connect() also refuses regular files, which must never be removed
+            struct stat status{};
+            if (::lstat(address.sun_path, &status) == 0 && !S_ISSOCK(status.st_mode))
+            {
+                return false;
+            }
+
+            const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (probe < 0)
+            {
+                return false;
+            }
+
+            const int result = ::connect(probe, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+            const int error = errno;
+            ::close(probe);
+            if (result == 0 || (error != ECONNREFUSED && error != ENOENT))
+            {
+                return false; // Another daemon is listening, or the path is not ours to remove
+            }
+
+            ::unlink(address.sun_path);
+            return true;
+        }
+
+        /**
+         * @brief Resumes work on the executor; the coroutine frame owns the callable
+         */
+        template<typename Work>
+        Detail::DetachedTask RunOn(Executor &executor, Work work)
+        {
+            co_await ScheduleOn(executor);
+            work();
+        }
+
+        std::unique_ptr<PitchDetector> MakeDetector(const AnalysisSessionConfig &config)
+        {
+            switch (config.detector)
+            {
+            case AnalysisDetector::Yin:
+            {
+                YinPitchDetectorConfig yinConfig;
+                yinConfig.minFrequency = config.minFrequency;
+                yinConfig.maxFrequency = config.maxFrequency;
+                yinConfig.maxBufferSize = config.frameSize;
+                return std::make_unique<YinPitchDetector>(yinConfig);
+            }
+            case AnalysisDetector::Mpm:
+            {
+                MpmPitchDetectorConfig mpmConfig;
+                mpmConfig.minFrequency = config.minFrequency;
+                mpmConfig.maxFrequency = config.maxFrequency;
+                mpmConfig.maxBufferSize = config.frameSize;
+                return std::make_unique<MpmPitchDetector>(mpmConfig);
+            }
+            case AnalysisDetector::Hybrid:
+            {
+                HybridPitchDetectorConfig hybridConfig;
+                hybridConfig.yinConfig.minFrequency = config.minFrequency;
+                hybridConfig.yinConfig.maxFrequency = config.maxFrequency;
+                hybridConfig.yinConfig.maxBufferSize = config.frameSize;
+                hybridConfig.mpmConfig.minFrequency = config.minFrequency;
+                hybridConfig.mpmConfig.maxFrequency = config.maxFrequency;
+                hybridConfig.mpmConfig.maxBufferSize = config.frameSize;
+                return std::make_unique<HybridPitchDetector>(hybridConfig);
+            }
+            default:
+                return nullptr;
+            }
+        }
+
+        std::unique_ptr<PitchStabilizer> MakeStabilizer(const AnalysisSessionConfig &config)
+        {
+            switch (config.stabilizer)
+            {
+            case AnalysisStabilizer::Ema:
+                return std::make_unique<ExponentialMovingAverage>();
+            case AnalysisStabilizer::Median:
+                return std::make_unique<MedianFilter>();
+            case AnalysisStabilizer::Hybrid:
+                return std::make_unique<HybridStabilizer>();
+            default:
+                return nullptr;
+            }
+        }
+
+        /**
+         * @brief Creates an anonymous shared memory object of size bytes
+         * @return Descriptor, -1 on failure
+         */
+        int CreateSharedMemory(size_t size)
+        {
+            const std::string name = "/guitar-dsp-" + std::to_string(::getpid()) + "-"
+                                     + std::to_string(regionCounter.fetch_add(1, std::memory_order_relaxed));
+
+            const int descriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (descriptor < 0)
+            {
+                return -1;
+            }
+
+            // Unlinked at once: the object lives exactly as long as its descriptors and mappings.
+            // Backing is reserved up front so a full /dev/shm fails here instead of raising SIGBUS later.
+            ::shm_unlink(name.c_str());
+            if (::ftruncate(descriptor, static_cast<off_t>(size)) != 0
+                || ::posix_fallocate(descriptor, 0, static_cast<off_t>(size)) != 0)
+            {
+                ::close(descriptor);
+                return -1;
+            }
+            return descriptor;
+        }
+
+        /**
+         * @brief Sends the handshake response, attaching descriptor if it is valid
+         */
+        bool SendResponse(int socket, const AnalysisResponse &response, int descriptor)
+        {
+            iovec data{ const_cast<AnalysisResponse *>(&response), sizeof(response) };
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+            msghdr message{};
+            message.msg_iov = &data;
+            message.msg_iovlen = 1;
+
+            if (descriptor >= 0)
+            {
+                message.msg_control = control;
+                message.msg_controllen = sizeof(control);
+                cmsghdr *entry = CMSG_FIRSTHDR(&message);
+                entry->cmsg_level = SOL_SOCKET;
+                entry->cmsg_type = SCM_RIGHTS;
+                entry->cmsg_len = CMSG_LEN(sizeof(int));
+                std::memcpy(CMSG_DATA(entry), &descriptor, sizeof(int));
+            }
+
+            ssize_t sent = 0;
+            do
+            {
+                sent = ::sendmsg(socket, &message, SEND_FLAGS);
+            } while (sent < 0 && errno == EINTR);
+            return sent == static_cast<ssize_t>(sizeof(response));
+        }
+    } // namespace
+
+    /**
+     * @brief One client connection and, after the handshake, its pipeline
+     */
+    struct AnalysisServer::Session
+    {
+        explicit Session(int socket)
+            : socket(socket), acceptedAt(std::chrono::steady_clock::now()), region(nullptr), regionSize(0),
+              header(nullptr), audio(nullptr), results(nullptr), config(), consumed(0), busy(false), closed(false)
+        {
+        }
+
+        ~Session()
+        {
+            if (region != nullptr)
+            {
+                ::munmap(region, regionSize);
+            }
+            if (socket >= 0)
+            {
+                ::close(socket);
+            }
+        }
+
+        Session(const Session &) = delete;
+        Session &operator=(const Session &) = delete;
+        Session(Session &&) = delete;
+        Session &operator=(Session &&) = delete;
+
+        /**
+         * @brief Returns true if a full hop is waiting in the input ring
+         */
+        bool HasPendingHop() const
+        {
+            return header->audioWrite.load(std::memory_order_acquire) - consumed >= config.hopSize;
+        }
+
+        /**
+         * @brief Analyses pending hops (at most one ring's worth per call, for fairness)
+         */
+        void Process()
+        {
+            const size_t hop = config.hopSize;
+            const size_t frameSize = config.frameSize;
+            const size_t capacity = config.audioCapacity;
+
+            // Counters are client-controlled: never trust them for more than one ring per pass
+            for (size_t pass = 0; pass < capacity / hop && HasPendingHop(); ++pass)
+            {
+                std::copy(frame.begin() + static_cast<std::ptrdiff_t>(hop), frame.end(), frame.begin());
+
+                float *destination = frame.data() + frameSize - hop;
+                const size_t index = static_cast<size_t>(consumed) & (capacity - 1);
+                const size_t firstPart = std::min(hop, capacity - index);
+                std::copy_n(audio + index, firstPart, destination);
+                std::copy_n(audio, hop - firstPart, destination + firstPart);
+
+                consumed += hop;
+                header->audioRead.store(consumed, std::memory_order_release);
+
+                if (consumed >= frameSize)
+                {
+                    Publish(consumed - frameSize, detector->Detect(frame, config.sampleRate));
+                }
+            }
+        }
+
+        /**
+         * @brief Stabilizes result and appends it to the result ring
+         */
+        void Publish(uint64_t frameStart, const std::optional<PitchResult> &result)
+        {
+            PitchResult value = result.value_or(PitchResult{ 0.0f, 0.0f });
+            if (stabilizer && result)
+            {
+                stabilizer->Update(*result);
+                value = stabilizer->GetStabilized();
+            }
+
+            const uint64_t write = header->resultWrite.load(std::memory_order_relaxed);
+            const uint64_t read = header->resultRead.load(std::memory_order_acquire);
+            if (write - read >= config.resultCapacity)
+            {
+                header->droppedResults.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            results[static_cast<size_t>(write) & (config.resultCapacity - 1)] =
+                AnalysisResult{ frameStart, value.frequency, value.confidence, result ? 1u : 0u, 0 };
+            header->resultWrite.store(write + 1, std::memory_order_release);
+        }
+
+        int socket;                                       ///< Control connection
+        std::chrono::steady_clock::time_point acceptedAt; ///< Connection time (handshake deadline)
+        void *region;                                     ///< Mapped shared memory (null before the handshake)
+        size_t regionSize;                                ///< Mapped bytes
+        AnalysisSharedHeader *header;                     ///< Ring counters
+        float *audio;                                     ///< Audio ring
+        AnalysisResult *results;                          ///< Result ring
+        AnalysisSessionConfig config;                     ///< Accepted pipeline (daemon's copy of the ring sizes)
+        std::unique_ptr<PitchDetector> detector;          ///< Session detector
+        std::unique_ptr<PitchStabilizer> stabilizer;      ///< Session stabilizer (optional)
+        std::vector<float> frame;                         ///< Sliding analysis frame
+        uint64_t consumed;                                ///< Samples taken from the audio ring
+        std::atomic<bool> busy;                           ///< A worker owns the session
+        bool closed;                                      ///< Connection ended; reap once idle
+    };
+
+    AnalysisServer::AnalysisServer(const AnalysisServerConfig &config)
+        : config(config), listenSocket(-1), acceptPaused(false), stopping(false), sessionCount(0), sessions(),
+          executor(ThreadPoolExecutorConfig{ config.threadCount })
+    {
+    }
+
+    AnalysisServer::~AnalysisServer()
+    {
+        if (listenSocket >= 0)
+        {
+            ::close(listenSocket);
+            ::unlink(config.socketPath.c_str());
+        }
+    }
+
+    bool AnalysisServer::Start()
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (listenSocket >= 0 || config.socketPath.size() >= sizeof(address.sun_path))
+        {
+            return false;
+        }
+        std::strcpy(address.sun_path, config.socketPath.c_str());
+
+        // A socket file left by a crashed daemon would make bind() fail
+        if (!RemoveStaleSocket(address))
+        {
+            return false;
+        }
+
+        listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenSocket < 0)
+        {
+            return false;
+        }
+
+        if (::bind(listenSocket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0
+            || ::listen(listenSocket, LISTEN_BACKLOG) != 0)
+        {
+            ::close(listenSocket);
+            listenSocket = -1;
+            return false;
+        }
+        return true;
+    }
+
+    void AnalysisServer::Run()
+    {
+        std::vector<pollfd> descriptors;
+        std::vector<Session *> polled;
+
+        while (!stopping.load(std::memory_order_acquire))
+        {
+            descriptors.clear();
+            polled.clear();
+            descriptors.push_back(pollfd{ listenSocket, static_cast<short>(acceptPaused ? 0 : POLLIN), 0 });
+            for (const auto &session : sessions)
+            {
+                if (!session->closed)
+                {
+                    descriptors.push_back(pollfd{ session->socket, POLLIN, 0 });
+                    polled.push_back(session.get());
+                }
+            }
+
+            const int ready =
+                ::poll(descriptors.data(), descriptors.size(), static_cast<int>(config.pollIntervalMs));
+            if (ready > 0)
+            {
+                for (size_t i = 0; i < polled.size(); ++i)
+                {
+                    if (descriptors[i + 1].revents != 0 && !HandleControl(*polled[i]))
+                    {
+                        polled[i]->closed = true;
+                        if (polled[i]->region != nullptr)
+                        {
+                            sessionCount.fetch_sub(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+                if ((descriptors[0].revents & POLLIN) != 0)
+                {
+                    Accept();
+                }
+            }
+
+            ExpireHandshakes();
+            DispatchPending();
+            ReapClosed();
+        }
+    }
+
+    void AnalysisServer::Stop()
+    {
+        stopping.store(true, std::memory_order_release);
+    }
+
+    size_t AnalysisServer::GetSessionCount() const
+    {
+        return sessionCount.load(std::memory_order_relaxed);
+    }
+
+    void AnalysisServer::Accept()
+    {
+        const int socket = ::accept(listenSocket, nullptr, nullptr);
+        if (socket < 0)
+        {
+            // Out of descriptors the listen socket stays readable: stop polling it until a session is reaped
+            if (errno == EMFILE || errno == ENFILE)
+            {
+                acceptPaused = true;
+            }
+            return;
+        }
+
+        const auto awaitingRequest = [](const std::unique_ptr<Session> &session) {
+            return session->region == nullptr && !session->closed;
+        };
+        const auto pending = std::count_if(sessions.begin(), sessions.end(), awaitingRequest);
+        if (static_cast<size_t>(pending) >= config.maxPendingHandshakes)
+        {
+            ::close(socket);
+            return;
+        }
+
+        std::unique_ptr<Session> session;
+        try
+        {
+            session = std::make_unique<Session>(socket);
+            sessions.push_back(std::move(session));
+        }
+        catch (const std::bad_alloc &)
+        {
+            // A session that was built owns (and closes) the socket
+            if (!session)
+            {
+                ::close(socket);
+            }
+        }
+    }
+
+    bool AnalysisServer::HandleControl(Session &session)
+    {
+        if (session.region != nullptr)
+        {
+            // Established sessions send nothing; any data is discarded, end of stream closes
+            char discard[64];
+            const ssize_t received = ::recv(session.socket, discard, sizeof(discard), MSG_DONTWAIT);
+            return received > 0 || (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+        }
+
+        // The request is a few dozen bytes written at once: a short read is a broken client
+        AnalysisRequest request{};
+        const ssize_t received = ::recv(session.socket, &request, sizeof(request), MSG_DONTWAIT);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            return true;
+        }
+        return received == static_cast<ssize_t>(sizeof(request)) && OpenSession(session, request);
+    }
+
+    bool AnalysisServer::OpenSession(Session &session, const AnalysisRequest &request)
+    {
+        const auto reject = [&session](AnalysisStatus status) {
+            SendResponse(session.socket, AnalysisResponse{ ANALYSIS_PROTOCOL_MAGIC, status, 0 }, -1);
+            return false;
+        };
+
+        if (request.magic != ANALYSIS_PROTOCOL_MAGIC || request.version != ANALYSIS_PROTOCOL_VERSION)
+        {
+            return reject(AnalysisStatus::VersionMismatch);
+        }
+        if (!IsValidAnalysisConfig(request.config))
+        {
+            return reject(AnalysisStatus::InvalidConfig);
+        }
+        if (sessionCount.load(std::memory_order_relaxed) >= config.maxSessions)
+        {
+            return reject(AnalysisStatus::SessionLimit);
+        }
+
+        const AnalysisSessionConfig &sessionConfig = request.config;
+        const AnalysisSharedLayout layout =
+            GetAnalysisSharedLayout(sessionConfig.audioCapacity, sessionConfig.resultCapacity);
+
+        // Everything that allocates runs before the region is mapped, so failure needs no unwinding
+        std::unique_ptr<PitchDetector> detector;
+        std::unique_ptr<PitchStabilizer> stabilizer;
+        std::vector<float> frame;
+        int descriptor = -1;
+        try
+        {
+            detector = MakeDetector(sessionConfig);
+            stabilizer = MakeStabilizer(sessionConfig);
+            frame.assign(sessionConfig.frameSize, 0.0f);
+            descriptor = CreateSharedMemory(layout.totalSize);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return reject(AnalysisStatus::OutOfMemory);
+        }
+
+        void *mapping = descriptor >= 0
+                            ? ::mmap(nullptr, layout.totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0)
+                            : MAP_FAILED;
+        if (mapping == MAP_FAILED)
+        {
+            if (descriptor >= 0)
+            {
+                ::close(descriptor);
+            }
+            return reject(AnalysisStatus::OutOfMemory);
+        }
+
+        session.region = mapping;
+        session.regionSize = layout.totalSize;
+        session.header = new (mapping) AnalysisSharedHeader{};
+        session.header->magic = ANALYSIS_PROTOCOL_MAGIC;
+        session.header->version = ANALYSIS_PROTOCOL_VERSION;
+        session.header->audioCapacity = sessionConfig.audioCapacity;
+        session.header->resultCapacity = sessionConfig.resultCapacity;
+        session.audio = reinterpret_cast<float *>(static_cast<char *>(mapping) + layout.audioOffset);
+        session.results = reinterpret_cast<AnalysisResult *>(static_cast<char *>(mapping) + layout.resultOffset);
+        session.config = sessionConfig;
+        session.detector = std::move(detector);
+        session.stabilizer = std::move(stabilizer);
+        session.frame = std::move(frame);
+        sessionCount.fetch_add(1, std::memory_order_relaxed);
+
+        // On failure the session is closed by the caller and the count released with it
+        const AnalysisResponse response{ ANALYSIS_PROTOCOL_MAGIC, AnalysisStatus::Ok, layout.totalSize };
+        const bool sent = SendResponse(session.socket, response, descriptor);
+        ::close(descriptor);
+        return sent;
+    }
+
+    void AnalysisServer::DispatchPending()
+    {
+        for (const auto &session : sessions)
+        {
+            if (session->closed || session->region == nullptr || session->busy.load(std::memory_order_acquire)
+                || !session->HasPendingHop())
+            {
+                continue;
+            }
+
+            session->busy.store(true, std::memory_order_relaxed);
+            Session *target = session.get();
+            RunOn(executor, [target] {
+                target->Process();
+                target->busy.store(false, std::memory_order_release);
+            });
+        }
+    }
+
+    void AnalysisServer::ExpireHandshakes()
+    {
+        const auto deadline =
+            std::chrono::steady_clock::now() - std::chrono::milliseconds(config.handshakeTimeoutMs);
+        for (const auto &session : sessions)
+        {
+            if (session->region == nullptr && !session->closed && session->acceptedAt < deadline)
+            {
+                session->closed = true;
+            }
+        }
+    }
+
+    void AnalysisServer::ReapClosed()
+    {
+        const size_t reaped = std::erase_if(sessions, [](const std::unique_ptr<Session> &session) {
+            return session->closed && !session->busy.load(std::memory_order_acquire);
+        });
+
+        // Descriptors were released: accepting may succeed again
+        if (reaped > 0)
+        {
+            acceptPaused = false;
+        }
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "AnalysisProtocol.h"
+#include "AsyncDetection.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Configuration for the analysis daemon
+     */
+    struct AnalysisServerConfig
+    {
+        std::string socketPath = DEFAULT_ANALYSIS_SOCKET; ///< Control socket path (replaced if stale)
+        size_t threadCount = 0;                           ///< Analysis workers (0 = hardware concurrency)
+        size_t maxSessions = 32;                          ///< Concurrent sessions accepted
+        size_t maxPendingHandshakes = 16;                 ///< Connections awaiting their request (more are closed)
+        uint32_t handshakeTimeoutMs = 2000;               ///< Connections without a request by then are closed
+        uint32_t pollIntervalMs = 2;                      ///< Period of the input ring scan (ms)
+    };
+
+    /**
+     * @brief Shared-memory analysis server behind guitar-dsp-daemon
+     *
+     * Clients connect to a Unix-domain socket and send an AnalysisRequest.
+     * The server creates an anonymous shared memory region for the session,
+     * passes its descriptor back with SCM_RIGHTS and from then on exchanges
+     * audio and results through the rings in that region only. Closing the
+     * connection ends the session. At most maxPendingHandshakes connections
+     * may wait for their request, each for at most handshakeTimeoutMs.
+     * Session setup that runs out of memory is answered with OutOfMemory.
+     *
+     * Run() owns the socket and scans every session's input ring each
+     * pollIntervalMs; a session with at least one hop pending is handed to
+     * the ThreadPoolExecutor, where its detector and stabilizer run until
+     * the ring is drained. A session is processed by at most one worker at
+     * a time, so detectors need no locking.
+     */
+    class AnalysisServer
+    {
+    public:
+        /**
+         * @brief Constructs server and starts the worker pool
+         * @param config Server configuration
+         */
+        explicit AnalysisServer(const AnalysisServerConfig &config = AnalysisServerConfig{});
+
+        ~AnalysisServer();
+
+        AnalysisServer(const AnalysisServer &) = delete;
+        AnalysisServer &operator=(const AnalysisServer &) = delete;
+        AnalysisServer(AnalysisServer &&) = delete;
+        AnalysisServer &operator=(AnalysisServer &&) = delete;
+
+        /**
+         * @brief Binds and listens on the control socket
+         * @return False if the socket could not be created or the path is in use (live daemon, non-socket file)
+         */
+        bool Start();
+
+        /**
+         * @brief Serves clients until Stop() is called
+         */
+        void Run();
+
+        /**
+         * @brief Asks Run() to return (async-signal-safe)
+         */
+        void Stop();
+
+        /**
+         * @brief Returns number of open sessions
+         */
+        [[nodiscard]] size_t GetSessionCount() const;
+
+    private:
+        struct Session;
+
+        /**
+         * @brief Accepts a pending connection as a session awaiting its handshake
+         */
+        void Accept();
+
+        /**
+         * @brief Handles readable control data of a session
+         * @return False if the session must be closed
+         */
+        bool HandleControl(Session &session);
+
+        /**
+         * @brief Validates the request, creates the shared region and replies
+         * @return False if the session must be closed
+         */
+        bool OpenSession(Session &session, const AnalysisRequest &request);
+
+        /**
+         * @brief Hands every idle session with a pending hop to the worker pool
+         */
+        void DispatchPending();
+
+        /**
+         * @brief Closes connections that did not send their request in time
+         */
+        void ExpireHandshakes();
+
+        /**
+         * @brief Removes closed sessions that no worker is processing
+         */
+        void ReapClosed();
+
+        AnalysisServerConfig config;                    ///< Server configuration
+        int listenSocket;                               ///< Control socket (-1 before Start)
+        bool acceptPaused;                              ///< accept() ran out of descriptors; resumed on reap
+        std::atomic<bool> stopping;                     ///< Set by Stop()
+        std::atomic<size_t> sessionCount;               ///< Open sessions
+        std::vector<std::unique_ptr<Session>> sessions; ///< Connected clients
+        ThreadPoolExecutor executor;                    ///< Analysis workers (destroyed first: drains sessions)
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "KernelDispatch.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Accumulation precision for correlation and normalisation sums
+     */
+    enum class AccumulationPrecision
+    {
+        Float,      ///< Plain float accumulation (fastest)
+        Double,     ///< Products and sums evaluated in double
+        Compensated ///< Float with Kahan-compensated summation
+    };
+
+    /**
+     * @brief Number of independent partial sums used by the kernels
+     *
+     * Independent lanes break the loop-carried dependency so the compiler can
+     * map the inner loop onto SIMD registers, and as a side effect reduce
+     * rounding error roughly by a factor of the lane count.
+     */
+    inline constexpr size_t ACCUMULATION_LANES = 8;
+
+    /**
+     * @brief Plain float accumulation policy
+     *
+     * For the three built-in policies the span kernels below run the
+     * runtime-dispatched SIMD implementations (see KernelDispatch.h); other
+     * policies use the portable lane loop.
+     */
+    struct FloatAccumulation
+    {
+        using Term = float; ///< Type products are evaluated in
+
+        /**
+         * @brief Single running sum
+         */
+        struct Accumulator
+        {
+            float sum = 0.0f; ///< Running sum
+
+            void Add(float value)
+            {
+                sum += value;
+            }
+
+            [[nodiscard]] double Value() const
+            {
+                return sum;
+            }
+        };
+    };
+
+    /**
+     * @brief Double-precision accumulation policy
+     */
+    struct DoubleAccumulation
+    {
+        using Term = double; ///< Type products are evaluated in
+
+        /**
+         * @brief Single running sum
+         */
+        struct Accumulator
+        {
+            double sum = 0.0; ///< Running sum
+
+            void Add(double value)
+            {
+                sum += value;
+            }
+
+            [[nodiscard]] double Value() const
+            {
+                return sum;
+            }
+        };
+    };
+
+    /**
+     * @brief Float accumulation with Kahan compensation
+     *
+     * Keeps float storage and throughput while carrying the rounding error of
+     * every addition in a second register. Requires IEEE semantics: do not
+     * build with -ffast-math (or /fp:fast), which removes the compensation.
+     */
+    struct CompensatedAccumulation
+    {
+        using Term = float; ///< Type products are evaluated in
+
+        /**
+         * @brief Single compensated running sum
+         */
+        struct Accumulator
+        {
+            float sum = 0.0f;          ///< Running sum
+            float compensation = 0.0f; ///< Lost low-order bits
+
+            void Add(float value)
+            {
+                const float corrected = value - compensation;
+                const float next = sum + corrected;
+                compensation = (next - sum) - corrected;
+                sum = next;
+            }
+
+            [[nodiscard]] double Value() const
+            {
+                return static_cast<double>(sum) - static_cast<double>(compensation);
+            }
+        };
+    };
+
+    namespace Detail
+    {
+        /**
+         * @brief Applies term function over [0, count) into lane-blocked accumulators
+         */
+        template<typename Policy, typename TermFunction>
+        double AccumulateLanes(size_t count, TermFunction term)
+        {
+            std::array<typename Policy::Accumulator, ACCUMULATION_LANES> lanes{};
+
+            size_t i = 0;
+            for (; i + ACCUMULATION_LANES <= count; i += ACCUMULATION_LANES)
+            {
+                for (size_t lane = 0; lane < ACCUMULATION_LANES; ++lane)
+                {
+                    lanes[lane].Add(term(i + lane));
+                }
+            }
+
+            for (; i < count; ++i)
+            {
+                lanes[i % ACCUMULATION_LANES].Add(term(i));
+            }
+
+            double total = 0.0;
+            for (const auto &lane : lanes)
+            {
+                total += lane.Value();
+            }
+
+            return total;
+        }
+    } // namespace Detail
+
+    /**
+     * @brief Dot product sum(a[i] * b[i]) using accumulation policy
+     * @param a First operand
+     * @param b Second operand (summed over the shorter length)
+     * @return Accumulated sum
+     */
+    template<typename Policy>
+    [[nodiscard]] double DotProduct(std::span<const float> a, std::span<const float> b)
+    {
+        using Term = typename Policy::Term;
+        const size_t count = std::min(a.size(), b.size());
+        const float *pa = a.data();
+        const float *pb = b.data();
+
+        if constexpr (std::is_same_v<Policy, FloatAccumulation>)
+        {
+            return GetKernels().dotProduct(pa, pb, count);
+        }
+        else if constexpr (std::is_same_v<Policy, DoubleAccumulation>)
+        {
+            return GetKernels().dotProductDouble(pa, pb, count);
+        }
+        else if constexpr (std::is_same_v<Policy, CompensatedAccumulation>)
+        {
+            return GetKernels().dotProductCompensated(pa, pb, count);
+        }
+        else
+        {
+            return Detail::AccumulateLanes<Policy>(
+                count, [pa, pb](size_t i) { return static_cast<Term>(pa[i]) * static_cast<Term>(pb[i]); });
+        }
+    }
+
+    /**
+     * @brief Squared difference sum(a[i] - b[i])^2 using accumulation policy
+     * @param a First operand
+     * @param b Second operand (summed over the shorter length)
+     * @return Accumulated sum
+     */
+    template<typename Policy>
+    [[nodiscard]] double SquaredDifferenceSum(std::span<const float> a, std::span<const float> b)
+    {
+        using Term = typename Policy::Term;
+        const size_t count = std::min(a.size(), b.size());
+        const float *pa = a.data();
+        const float *pb = b.data();
+
+        if constexpr (std::is_same_v<Policy, FloatAccumulation>)
+        {
+            return GetKernels().squaredDifferenceSum(pa, pb, count);
+        }
+        else if constexpr (std::is_same_v<Policy, DoubleAccumulation>)
+        {
+            return GetKernels().squaredDifferenceSumDouble(pa, pb, count);
+        }
+        else if constexpr (std::is_same_v<Policy, CompensatedAccumulation>)
+        {
+            return GetKernels().squaredDifferenceSumCompensated(pa, pb, count);
+        }
+        else
+        {
+            return Detail::AccumulateLanes<Policy>(count, [pa, pb](size_t i) {
+                const Term delta = static_cast<Term>(pa[i]) - static_cast<Term>(pb[i]);
+                return delta * delta;
+            });
+        }
+    }
+
+    /**
+     * @brief Sum of squares sum(a[i]^2) using accumulation policy
+     * @param a Operand
+     * @return Accumulated sum
+     */
+    template<typename Policy>
+    [[nodiscard]] double SumOfSquares(std::span<const float> a)
+    {
+        using Term = typename Policy::Term;
+        const float *pa = a.data();
+
+        if constexpr (std::is_same_v<Policy, FloatAccumulation>)
+        {
+            return GetKernels().sumOfSquares(pa, a.size());
+        }
+        else if constexpr (std::is_same_v<Policy, DoubleAccumulation>)
+        {
+            return GetKernels().sumOfSquaresDouble(pa, a.size());
+        }
+        else if constexpr (std::is_same_v<Policy, CompensatedAccumulation>)
+        {
+            return GetKernels().sumOfSquaresCompensated(pa, a.size());
+        }
+        else
+        {
+            return Detail::AccumulateLanes<Policy>(a.size(), [pa](size_t i) {
+                const auto value = static_cast<Term>(pa[i]);
+                return value * value;
+            });
+        }
+    }
+
+} // namespace GuitarDSP
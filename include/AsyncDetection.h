@@ -0,0 +1,562 @@
+#pragma once
+
+#include "PitchDetector.h"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Resumes suspended coroutines on some execution context
+     */
+    class Executor
+    {
+    public:
+        virtual ~Executor() = default;
+
+        /**
+         * @brief Queues coroutine for resumption
+         * @param handle Suspended coroutine
+         */
+        virtual void Schedule(std::coroutine_handle<> handle) = 0;
+    };
+
+    /**
+     * @brief Configuration for thread pool executor
+     */
+    struct ThreadPoolExecutorConfig
+    {
+        size_t threadCount = 0; ///< Worker threads (0 = hardware concurrency)
+    };
+
+    /**
+     * @brief Small FIFO thread pool executor
+     *
+     * Coroutines are resumed in the order they were scheduled, so tasks that
+     * yield between chunks interleave fairly. Queued coroutines are drained
+     * before the destructor joins the workers.
+     */
+    class ThreadPoolExecutor : public Executor
+    {
+    public:
+        /**
+         * @brief Starts worker threads
+         * @param config Executor configuration
+         */
+        explicit ThreadPoolExecutor(const ThreadPoolExecutorConfig &config = ThreadPoolExecutorConfig{});
+
+        ~ThreadPoolExecutor() override;
+
+        ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+        ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+        ThreadPoolExecutor(ThreadPoolExecutor &&) = delete;
+        ThreadPoolExecutor &operator=(ThreadPoolExecutor &&) = delete;
+
+        void Schedule(std::coroutine_handle<> handle) override;
+
+        /**
+         * @brief Returns number of worker threads
+         */
+        [[nodiscard]] size_t GetThreadCount() const;
+
+    private:
+        /**
+         * @brief Resumes queued coroutines until stopped and drained
+         */
+        void WorkerLoop();
+
+        std::mutex mutex;                          ///< Guards queue and stopping
+        std::condition_variable condition;         ///< Signals queued work or shutdown
+        std::deque<std::coroutine_handle<>> queue; ///< Coroutines waiting to resume
+        std::vector<std::thread> workers;          ///< Worker threads
+        bool stopping;                             ///< Set by destructor
+    };
+
+    /**
+     * @brief Awaitable that moves the awaiting coroutine onto an executor
+     *
+     * Awaiting it again from a coroutine already on the executor re-queues
+     * it behind other work, which is how long analyses yield.
+     */
+    class ScheduleOn
+    {
+    public:
+        /**
+         * @brief Creates awaitable
+         * @param executor Executor to continue on
+         */
+        explicit ScheduleOn(Executor &executor) : executor(executor)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            executor.Schedule(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+        Executor &executor; ///< Target executor
+    };
+
+    template<typename T>
+    class Task;
+
+    namespace Detail
+    {
+        /**
+         * @brief Promise members shared by Task<T> and Task<void>
+         */
+        struct TaskPromiseBase
+        {
+            /**
+             * @brief Transfers control to the awaiting coroutine when the task finishes
+             */
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+                {
+                    return handle.promise().continuation;
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            void RethrowIfFailed() const
+            {
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+
+            std::coroutine_handle<> continuation = std::noop_coroutine(); ///< Awaiting coroutine
+            std::exception_ptr exception;                                 ///< Exception escaping the task body
+        };
+
+        /**
+         * @brief Promise of Task<T>
+         */
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase
+        {
+            Task<T> get_return_object() noexcept;
+
+            void return_value(T result)
+            {
+                value.emplace(std::move(result));
+            }
+
+            T TakeResult()
+            {
+                RethrowIfFailed();
+                return std::move(*value);
+            }
+
+            std::optional<T> value; ///< Result of the task body
+        };
+
+        /**
+         * @brief Promise of Task<void>
+         */
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept
+            {
+            }
+
+            void TakeResult() const
+            {
+                RethrowIfFailed();
+            }
+        };
+
+        /**
+         * @brief Eagerly started, self-destroying coroutine used by SyncWait and WhenAll
+         */
+        struct DetachedTask
+        {
+            struct promise_type
+            {
+                DetachedTask get_return_object() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                void return_void() const noexcept
+                {
+                }
+
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+    } // namespace Detail
+
+    /**
+     * @brief Lazily started coroutine producing a value of type T
+     *
+     * The body runs when the task is awaited (or passed to SyncWait /
+     * WhenAll). Exceptions thrown by the body are rethrown to the awaiter.
+     * Move-only; destroying an unstarted or finished task frees its frame.
+     */
+    template<typename T = void>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = Detail::TaskPromise<T>;
+
+        Task(Task &&other) noexcept : handle(std::exchange(other.handle, {}))
+        {
+        }
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle)
+                {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            if (handle)
+            {
+                handle.destroy();
+            }
+        }
+
+        /**
+         * @brief Returns true once the body has finished
+         */
+        [[nodiscard]] bool IsDone() const
+        {
+            return !handle || handle.done();
+        }
+
+        auto operator co_await() & noexcept
+        {
+            return Awaiter{ handle };
+        }
+
+        auto operator co_await() && noexcept
+        {
+            return Awaiter{ handle };
+        }
+
+    private:
+        friend promise_type;
+
+        /**
+         * @brief Starts the task and resumes the awaiter when it finishes
+         */
+        struct Awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return !handle || handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() const
+            {
+                return handle.promise().TakeResult();
+            }
+
+            std::coroutine_handle<promise_type> handle; ///< Awaited task
+        };
+
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle; ///< Owned coroutine frame
+    };
+
+    namespace Detail
+    {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+
+        /**
+         * @brief Completion signal for SyncWait
+         */
+        struct SyncWaitState
+        {
+            std::mutex mutex;                  ///< Guards done
+            std::condition_variable condition; ///< Signals completion
+            bool done = false;                 ///< Task finished
+            std::exception_ptr exception;      ///< Exception thrown by the task
+        };
+
+        template<typename T>
+        DetachedTask RunSyncWait(Task<T> &task, std::optional<T> &result, SyncWaitState &state)
+        {
+            try
+            {
+                result.emplace(co_await task);
+            }
+            catch (...)
+            {
+                state.exception = std::current_exception();
+            }
+
+            // Notify under the lock: the waiter may destroy state as soon as it observes done
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.done = true;
+            state.condition.notify_one();
+        }
+
+        inline DetachedTask RunSyncWait(Task<void> &task, std::optional<bool> &result, SyncWaitState &state)
+        {
+            try
+            {
+                co_await task;
+                result.emplace(true);
+            }
+            catch (...)
+            {
+                state.exception = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.done = true;
+            state.condition.notify_one();
+        }
+
+        /**
+         * @brief Shared completion counter of a WhenAll group
+         */
+        struct WhenAllState
+        {
+            std::atomic<size_t> remaining{ 0 };         ///< Unfinished members plus the launcher
+            std::coroutine_handle<> continuation;       ///< Coroutine awaiting the group
+            std::atomic_flag failed = ATOMIC_FLAG_INIT; ///< Set by the first failing member
+            std::exception_ptr exception;               ///< First exception thrown by a member
+        };
+
+        inline DetachedTask RunWhenAllMember(Task<void> &task, WhenAllState &state)
+        {
+            try
+            {
+                co_await task;
+            }
+            catch (...)
+            {
+                if (!state.failed.test_and_set())
+                {
+                    state.exception = std::current_exception();
+                }
+            }
+
+            if (state.remaining.fetch_sub(1) == 1)
+            {
+                state.continuation.resume();
+            }
+        }
+
+        /**
+         * @brief Starts every task and resumes the awaiter after the last one finishes
+         */
+        class WhenAllAwaiter
+        {
+        public:
+            explicit WhenAllAwaiter(std::span<Task<void>> tasks) : tasks(tasks)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return tasks.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting)
+            {
+                state.continuation = awaiting;
+                state.remaining.store(tasks.size() + 1);
+                for (auto &task : tasks)
+                {
+                    RunWhenAllMember(task, state);
+                }
+
+                // Stay running if every member already finished on this thread
+                return state.remaining.fetch_sub(1) != 1;
+            }
+
+            void await_resume() const
+            {
+                if (state.exception)
+                {
+                    std::rethrow_exception(state.exception);
+                }
+            }
+
+        private:
+            std::span<Task<void>> tasks; ///< Group members
+            WhenAllState state;          ///< Completion counter
+        };
+    } // namespace Detail
+
+    /**
+     * @brief Runs task to completion, blocking the calling thread
+     * @param task Task to run (typically one that starts with ScheduleOn)
+     * @return Task result; exceptions from the task are rethrown
+     */
+    template<typename T>
+    T SyncWait(Task<T> task)
+    {
+        using Stored = std::conditional_t<std::is_void_v<T>, bool, T>;
+        std::optional<Stored> result;
+        Detail::SyncWaitState state;
+
+        Detail::RunSyncWait(task, result, state);
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.condition.wait(lock, [&state] { return state.done; });
+
+        if (state.exception)
+        {
+            std::rethrow_exception(state.exception);
+        }
+
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(*result);
+        }
+    }
+
+    /**
+     * @brief Runs all tasks concurrently and completes when the last one finishes
+     * @param tasks Tasks to start (must stay alive until the returned task completes)
+     * @return Task completing after all members; rethrows the first member exception
+     */
+    inline Task<void> WhenAll(std::span<Task<void>> tasks)
+    {
+        co_await Detail::WhenAllAwaiter(tasks);
+    }
+
+    /**
+     * @brief Detects pitch of one buffer on an executor
+     * @param detector Detector (must not be used concurrently by other tasks)
+     * @param buffer Input audio buffer (must stay alive until the task completes)
+     * @param sampleRate Sample rate in Hz
+     * @param executor Executor to run the detection on
+     * @return Pitch result if detected, nullopt otherwise
+     */
+    Task<std::optional<PitchResult>> DetectAsync(PitchDetector &detector,
+        std::span<const float> buffer,
+        float sampleRate,
+        Executor &executor);
+
+    /**
+     * @brief Configuration for asynchronous block analysis
+     */
+    struct AsyncBlockConfig
+    {
+        size_t frameSize = 4096;     ///< Analysis window (samples)
+        size_t hopSize = 512;        ///< Samples between consecutive frames
+        float sampleRate = 48000.0f; ///< Sample rate (Hz)
+        size_t framesPerChunk = 32;  ///< Frames analysed before yielding to the executor
+    };
+
+    /**
+     * @brief Detects pitch in every frame of a long signal, yielding between chunks
+     *
+     * Frame k covers samples [k * hopSize, k * hopSize + frameSize). Frames
+     * without a pitch are written as { 0, 0 }. After every framesPerChunk
+     * frames the task re-queues itself on the executor so one worker can
+     * interleave many clips. Memory is bounded by the caller's buffers and
+     * one coroutine frame per clip; no allocation happens per frame.
+     *
+     * @param detector Detector (must not be used concurrently by other tasks)
+     * @param signal Input signal (must stay alive until the task completes)
+     * @param results Output, one entry per frame
+     * @param config Framing and chunking
+     * @param executor Executor to run the analysis on
+     * @return Number of frames written (limited by results.size())
+     */
+    Task<size_t> ProcessBlockAsync(PitchDetector &detector,
+        std::span<const float> signal,
+        std::span<PitchResult> results,
+        AsyncBlockConfig config,
+        Executor &executor);
+
+} // namespace GuitarDSP
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Configuration for band-limiting pre-filter
+     *
+     * Corner frequencies follow the detector range so the passband matches
+     * what the detectors are configured to find.
+     */
+    struct BandLimitFilterConfig
+    {
+        float sampleRate = 48000.0f;     ///< Sample rate (Hz)
+        float minFrequency = 80.0f;      ///< Lowest frequency of interest (Hz), usually detector minFrequency
+        float maxFrequency = 1200.0f;    ///< Highest frequency of interest (Hz), usually detector maxFrequency
+        bool dcBlocker = true;           ///< Enable first-order DC blocker
+        float dcBlockerFrequency = 5.0f; ///< DC blocker corner (Hz)
+        uint32_t highPassOrder = 2;      ///< Butterworth high-pass order (0 = off, even, max 8)
+        float highPassRatio = 0.5f;      ///< High-pass corner as a fraction of minFrequency
+        uint32_t lowPassOrder = 4;       ///< Butterworth low-pass order (0 = off, even, max 8)
+        float lowPassRatio = 1.5f;       ///< Low-pass corner as a multiple of maxFrequency
+    };
+
+    /**
+     * @brief Band-limiting biquad cascade for detector input
+     *
+     * Removes DC offset, hum below the lowest string and pick noise above the
+     * highest note before the YIN/NSDF sums see it:
+     * DC blocker -> Butterworth high-pass -> Butterworth low-pass
+     *
+     * Sections are transposed direct form II with double precision state.
+     * Each sample runs through the whole cascade before the next is read, so
+     * state stays in registers across the block. State persists across
+     * calls, so consecutive blocks of a stream filter seamlessly: run it on
+     * the input stream before frames are cut, not on overlapping frames.
+     *
+     * Real-time safe: Coefficients and state live in fixed-size arrays.
+     */
+    class BandLimitFilter
+    {
+    public:
+        static constexpr size_t MAX_SECTIONS = 9; ///< DC blocker plus two order-8 filters
+
+        /**
+         * @brief Constructs filter and designs coefficients
+         * @param config Filter configuration
+         */
+        explicit BandLimitFilter(const BandLimitFilterConfig &config = BandLimitFilterConfig{});
+
+        /**
+         * @brief Filters block in place, continuing from the previous block
+         * @param samples Audio samples
+         */
+        void Process(std::span<float> samples);
+
+        /**
+         * @brief Filters block into separate output, continuing from the previous block
+         * @param input Audio samples
+         * @param output Filtered samples (at least input.size())
+         */
+        void Process(std::span<const float> input, std::span<float> output);
+
+        /**
+         * @brief Clears filter state
+         */
+        void Reset();
+
+        /**
+         * @brief Gets group delay of the cascade at a frequency
+         * @param frequency Frequency (Hz)
+         * @return Group delay in samples
+         */
+        [[nodiscard]] float GetGroupDelay(float frequency) const;
+
+        /**
+         * @brief Gets group delay at the geometric centre of the passband
+         *
+         * Suitable for PipelineLatencyConfig::prefilterGroupDelay.
+         *
+         * @return Group delay in samples
+         */
+        [[nodiscard]] float GetGroupDelay() const;
+
+        /**
+         * @brief Gets magnitude response of the cascade at a frequency
+         * @param frequency Frequency (Hz)
+         * @return Linear gain
+         */
+        [[nodiscard]] float GetMagnitudeResponse(float frequency) const;
+
+        /**
+         * @brief Returns number of active biquad sections
+         */
+        [[nodiscard]] size_t GetSectionCount() const;
+
+    private:
+        /**
+         * @brief Normalized biquad coefficients (a0 = 1)
+         */
+        struct Section
+        {
+            double b0; ///< Feed-forward coefficient z^0
+            double b1; ///< Feed-forward coefficient z^-1
+            double b2; ///< Feed-forward coefficient z^-2
+            double a1; ///< Feedback coefficient z^-1
+            double a2; ///< Feedback coefficient z^-2
+        };
+
+        /**
+         * @brief Appends Butterworth sections of given order
+         */
+        void AddButterworth(uint32_t order, double cutoff, bool highPass);
+
+        BandLimitFilterConfig config;                          ///< Filter configuration
+        std::array<Section, MAX_SECTIONS> sections;            ///< Active sections in processing order
+        std::array<std::array<double, 2>, MAX_SECTIONS> state; ///< Transposed direct form II state per section
+        size_t sectionCount;                                   ///< Number of active sections
+    };
+
+} // namespace GuitarDSP
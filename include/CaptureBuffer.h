@@ -0,0 +1,175 @@
+#pragma once
+
+#include "PitchDetector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Configuration for input capture ring
+     */
+    struct CaptureBufferConfig
+    {
+        float sampleRate = 48000.0f;    ///< Input sample rate (Hz)
+        float durationSeconds = 10.0f;  ///< Input history kept (seconds)
+        size_t maxFrames = 4096;        ///< Frame records kept
+        uint64_t freezeAboveCycles = 0; ///< Freeze automatically after a slower frame (0 = off)
+    };
+
+    /**
+     * @brief Timing and result of one analysed frame
+     */
+    struct CaptureFrameRecord
+    {
+        uint64_t frameStart; ///< Stream index of first sample in the frame
+        uint32_t frameSize;  ///< Frame length (samples)
+        uint64_t cycles;     ///< Detection time (StageProfiler::ReadCycleCounter ticks)
+        PitchResult result;  ///< Detected pitch ({ 0, 0 } if none)
+        bool valid;          ///< A pitch was detected
+    };
+
+    /**
+     * @brief Capture loaded from a dump
+     */
+    struct CaptureSnapshot
+    {
+        float sampleRate;                       ///< Input sample rate (Hz)
+        uint64_t firstSample;                   ///< Stream index of samples[0]
+        std::vector<float> samples;             ///< Retained input history
+        std::vector<CaptureFrameRecord> frames; ///< Retained frame records, oldest first
+
+        /**
+         * @brief Returns input of a recorded frame if it is fully retained
+         * @param frame Frame record
+         * @return Frame samples, empty if any part is no longer in the history
+         */
+        [[nodiscard]] std::span<const float> GetFrameSamples(const CaptureFrameRecord &frame) const;
+    };
+
+    /**
+     * @brief Always-on rolling capture of detector input, timings and results
+     *
+     * Keeps the last durationSeconds of input and the last maxFrames frame
+     * records so a CPU spike or bad reading seen in the field can be dumped
+     * and replayed locally (see tools/CaptureReplay.cpp).
+     *
+     * Dump layout (little-endian): magic "GCAP", version, sample rate, first
+     * sample index, sample count, record count, float samples, then records.
+     *
+     * The audio thread calls Push() and RecordFrame(). To dump from another
+     * thread, call Freeze(), wait until IsFrozen() (acknowledged by the next
+     * audio-thread call, which is then dropped), Dump(), then Resume().
+     *
+     * Real-time safe: Push() and RecordFrame() copy into pre-allocated rings.
+     */
+    class CaptureBuffer
+    {
+    public:
+        /**
+         * @brief Constructs capture and pre-allocates rings
+         * @param config Capture configuration
+         */
+        explicit CaptureBuffer(const CaptureBufferConfig &config = CaptureBufferConfig{});
+
+        CaptureBuffer(const CaptureBuffer &) = delete;
+        CaptureBuffer &operator=(const CaptureBuffer &) = delete;
+        CaptureBuffer(CaptureBuffer &&) = delete;
+        CaptureBuffer &operator=(CaptureBuffer &&) = delete;
+
+        /**
+         * @brief Appends input samples (dropped while frozen)
+         * @param input Next block of the input stream
+         */
+        void Push(std::span<const float> input);
+
+        /**
+         * @brief Records timing and result of an analysed frame (dropped while frozen)
+         * @param frameStart Stream index of first sample in the frame
+         * @param frameSize Frame length (samples)
+         * @param cycles Detection time in cycle counter ticks
+         * @param result Detection result
+         */
+        void RecordFrame(uint64_t frameStart,
+            size_t frameSize,
+            uint64_t cycles,
+            const std::optional<PitchResult> &result);
+
+        /**
+         * @brief Returns stream index of the next pushed sample
+         */
+        [[nodiscard]] uint64_t GetStreamPosition() const;
+
+        /**
+         * @brief Requests the audio thread to stop writing
+         */
+        void Freeze();
+
+        /**
+         * @brief Returns true once writing has stopped and Dump() is safe from any thread
+         */
+        [[nodiscard]] bool IsFrozen() const;
+
+        /**
+         * @brief Resumes capturing after Freeze() or an automatic freeze
+         */
+        void Resume();
+
+        /**
+         * @brief Writes retained history and records to stream
+         *
+         * Not real-time safe. Call from the writing thread or while frozen.
+         *
+         * @param stream Output stream (binary mode)
+         * @return False if the stream failed
+         */
+        bool Dump(std::ostream &stream) const;
+
+        /**
+         * @brief Loads a dump written by Dump()
+         * @param stream Input stream (binary mode)
+         * @return Snapshot, nullopt if the data is not a valid capture
+         */
+        [[nodiscard]] static std::optional<CaptureSnapshot> Load(std::istream &stream);
+
+        /**
+         * @brief Clears history and records and resumes capturing
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Capture state shared by the audio thread and the dumping thread
+         *
+         * Only Freeze() moves Running to Requested and only the writer moves
+         * Requested to Frozen, both by compare-exchange, so neither can undo a
+         * Resume() or Reset() that returned to Running in between.
+         */
+        enum class FreezeState : uint8_t
+        {
+            Running,   ///< Writer is capturing
+            Requested, ///< Freeze requested, not yet acknowledged by the writer
+            Frozen     ///< Writer has stopped
+        };
+
+        /**
+         * @brief Acknowledges a pending freeze
+         * @return True if the caller must drop its write
+         */
+        bool CheckFrozen();
+
+        CaptureBufferConfig config;             ///< Capture configuration
+        std::vector<float> samples;             ///< Input ring
+        std::vector<CaptureFrameRecord> frames; ///< Frame record ring
+        uint64_t samplesWritten;                ///< Total samples pushed (stream position)
+        uint64_t framesWritten;                 ///< Total frames recorded
+        std::atomic<FreezeState> freezeState;   ///< Freeze handshake (see FreezeState)
+    };
+
+} // namespace GuitarDSP
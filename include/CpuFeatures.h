@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Instruction set levels the library kernels are compiled for
+     */
+    enum class IsaLevel : uint32_t
+    {
+        Scalar, ///< Portable C++ (always available)
+        Sse2,   ///< x86 SSE2
+        Avx2,   ///< x86 AVX2 + FMA
+        Avx512, ///< x86 AVX-512F
+        Neon    ///< ARM NEON (AArch64)
+    };
+
+    /**
+     * @brief CPU feature detection and kernel ISA selection
+     *
+     * The kernel ISA is chosen once, on first use, as the best level that is
+     * both compiled into the library and supported by the running CPU. The
+     * GUITAR_DSP_ISA environment variable (scalar, sse2, avx2, avx512, neon)
+     * or SetIsaOverride() force a lower level for testing and comparison.
+     */
+    class CpuFeatures
+    {
+    public:
+        /**
+         * @brief Returns true if kernels for level are compiled in and supported by the CPU
+         */
+        [[nodiscard]] static bool IsSupported(IsaLevel level);
+
+        /**
+         * @brief Returns best level supported by both the library and the CPU
+         */
+        [[nodiscard]] static IsaLevel DetectBestLevel();
+
+        /**
+         * @brief Returns level of the kernels currently in use
+         */
+        [[nodiscard]] static IsaLevel GetActiveLevel();
+
+        /**
+         * @brief Forces kernels of a specific level
+         * @param level Requested level
+         * @return False if level is not supported (active level unchanged)
+         *
+         * Not intended to be called while audio is being processed: kernels
+         * already running keep the previous level until they return.
+         */
+        static bool SetIsaOverride(IsaLevel level);
+
+        /**
+         * @brief Restores automatic selection (GUITAR_DSP_ISA still applies)
+         */
+        static void ClearIsaOverride();
+
+        /**
+         * @brief Returns display name of a level
+         */
+        [[nodiscard]] static const char *GetLevelName(IsaLevel level);
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Occupancy statistics of a detector pool
+     */
+    struct PoolStatistics
+    {
+        size_t capacity;         ///< Objects constructed up front
+        size_t inUse;            ///< Objects currently handed out
+        size_t peakInUse;        ///< Highest inUse since construction
+        uint64_t acquireCount;   ///< Successful Acquire() calls
+        uint64_t exhaustedCount; ///< Acquire() calls that found the pool empty
+    };
+
+    /**
+     * @brief Fixed-capacity pool of pre-constructed detectors or stabilizers
+     *
+     * All objects are constructed once with the same arguments in one
+     * contiguous allocation. Acquire() hands out a free object through an
+     * RAII handle; releasing the handle calls Reset() on the object and puts
+     * it back, so every acquired object starts from a clean state.
+     *
+     * Acquire and release are O(1) and never allocate, which keeps session
+     * setup and teardown off the allocator in servers with many short-lived
+     * sessions. Thread-safe: the free list is guarded by a mutex; a handed
+     * out object belongs to its handle holder.
+     *
+     * @tparam T Pooled type with a Reset() method (e.g. HybridPitchDetector, HybridStabilizer)
+     */
+    template<typename T>
+        requires requires(T &object) { object.Reset(); }
+    class DetectorPool
+    {
+    public:
+        /**
+         * @brief Exclusive ownership of one pooled object, returned on destruction
+         */
+        class Handle
+        {
+        public:
+            Handle() = default;
+
+            Handle(Handle &&other) noexcept
+                : pool(std::exchange(other.pool, nullptr)), object(std::exchange(other.object, nullptr))
+            {
+            }
+
+            Handle &operator=(Handle &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    Release();
+                    pool = std::exchange(other.pool, nullptr);
+                    object = std::exchange(other.object, nullptr);
+                }
+                return *this;
+            }
+
+            Handle(const Handle &) = delete;
+            Handle &operator=(const Handle &) = delete;
+
+            ~Handle()
+            {
+                Release();
+            }
+
+            /**
+             * @brief Returns object to the pool early (no-op on an empty handle)
+             */
+            void Release()
+            {
+                if (pool != nullptr)
+                {
+                    pool->Return(object);
+                    pool = nullptr;
+                    object = nullptr;
+                }
+            }
+
+            /**
+             * @brief Returns the pooled object, nullptr for an empty handle
+             */
+            [[nodiscard]] T *Get() const
+            {
+                return object;
+            }
+
+            T *operator->() const
+            {
+                return object;
+            }
+
+            T &operator*() const
+            {
+                return *object;
+            }
+
+            explicit operator bool() const
+            {
+                return object != nullptr;
+            }
+
+        private:
+            friend class DetectorPool;
+
+            Handle(DetectorPool *pool, T *object) : pool(pool), object(object)
+            {
+            }
+
+            DetectorPool *pool = nullptr; ///< Owning pool
+            T *object = nullptr;          ///< Pooled object
+        };
+
+        /**
+         * @brief Constructs capacity objects as T(args...) in contiguous storage
+         * @param capacity Number of objects
+         * @param args Constructor arguments shared by all objects (e.g. a config)
+         */
+        template<typename... Args>
+        explicit DetectorPool(size_t capacity, const Args &...args)
+            : storage(nullptr), capacity(capacity), freeList({}), inUse(0), peakInUse(0), acquireCount(0),
+              exhaustedCount(0)
+        {
+            storage = static_cast<T *>(::operator new(sizeof(T) * capacity, std::align_val_t{ alignof(T) }));
+
+            // A throwing constructor or reserve() must not leak the objects built so far or the storage
+            size_t constructed = 0;
+            try
+            {
+                freeList.reserve(capacity);
+                for (; constructed < capacity; ++constructed)
+                {
+                    new (storage + constructed) T(args...);
+                }
+            }
+            catch (...)
+            {
+                while (constructed > 0)
+                {
+                    storage[--constructed].~T();
+                }
+                ::operator delete(storage, std::align_val_t{ alignof(T) });
+                throw;
+            }
+
+            // Free list is a stack; push in reverse so the first object is handed out first
+            for (size_t i = capacity; i > 0; --i)
+            {
+                freeList.push_back(storage + i - 1);
+            }
+        }
+
+        /**
+         * @brief Destroys all objects (all handles must have been released)
+         */
+        ~DetectorPool()
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                storage[i].~T();
+            }
+            ::operator delete(storage, std::align_val_t{ alignof(T) });
+        }
+
+        DetectorPool(const DetectorPool &) = delete;
+        DetectorPool &operator=(const DetectorPool &) = delete;
+        DetectorPool(DetectorPool &&) = delete;
+        DetectorPool &operator=(DetectorPool &&) = delete;
+
+        /**
+         * @brief Hands out a reset object
+         * @return Handle owning the object, empty if the pool is exhausted
+         */
+        [[nodiscard]] Handle Acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (freeList.empty())
+            {
+                ++exhaustedCount;
+                return Handle();
+            }
+
+            T *object = freeList.back();
+            freeList.pop_back();
+
+            ++inUse;
+            ++acquireCount;
+            peakInUse = std::max(peakInUse, inUse);
+
+            return Handle(this, object);
+        }
+
+        /**
+         * @brief Returns current occupancy statistics
+         */
+        [[nodiscard]] PoolStatistics GetStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return PoolStatistics{ capacity, inUse, peakInUse, acquireCount, exhaustedCount };
+        }
+
+    private:
+        /**
+         * @brief Resets object and puts it back on the free list
+         */
+        void Return(T *object)
+        {
+            // Reset outside the lock; the object is still exclusively owned here
+            object->Reset();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            freeList.push_back(object);
+            --inUse;
+        }
+
+        T *storage;                ///< Contiguous object storage
+        size_t capacity;           ///< Number of objects
+        mutable std::mutex mutex;  ///< Guards free list and statistics
+        std::vector<T *> freeList; ///< Free objects (capacity reserved, never grows)
+        size_t inUse;              ///< Objects handed out
+        size_t peakInUse;          ///< Highest inUse
+        uint64_t acquireCount;     ///< Successful acquisitions
+        uint64_t exhaustedCount;   ///< Failed acquisitions
+    };
+
+} // namespace GuitarDSP
@@ -82,6 +82,17 @@ namespace GuitarDSP
          */
         void ComputeSpectrum(std::span<const float> audioData);
 
+        /**
+         * @brief Compute FFT spectrum from audio data into an external spectrum
+         * @param audioData Input audio samples (must be >= fftSize)
+         * @param output Destination, its data must already hold fftSize floats (left unchanged otherwise)
+         *
+         * Lets the transform write straight into a caller-owned buffer, such
+         * as the write side of a TripleBuffer, instead of being copied out.
+         * Real-time safe: No allocations.
+         */
+        void ComputeSpectrum(std::span<const float> audioData, FFTSpectrum &output);
+
         /**
          * @brief Get computed spectrum
          * @return Reference to most recent spectrum
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "PitchDetector.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Stream position of an analysis frame
+     */
+    struct FrameStamp
+    {
+        uint64_t frameStart; ///< Stream index of first sample in the analysis window
+        double windowCentre; ///< Stream position of window centre (samples)
+        uint64_t hopIndex;   ///< Zero-based frame (hop) counter
+    };
+
+    /**
+     * @brief Pitch result stamped with the stream position it applies to
+     */
+    struct TimedPitchResult
+    {
+        PitchResult result; ///< Pitch detection result
+        FrameStamp stamp;   ///< Position of the analysed frame
+    };
+
+    /**
+     * @brief Configuration for frame clock
+     */
+    struct FrameClockConfig
+    {
+        size_t windowSize = 4096;    ///< Analysis window length (samples)
+        size_t hopSize = 512;        ///< Samples between consecutive frames
+        float sampleRate = 48000.0f; ///< Sample rate (Hz)
+    };
+
+    /**
+     * @brief Tracks stream position of sliding analysis frames
+     *
+     * Frame k covers samples [startSample + k * hopSize, ... + windowSize).
+     * Estimates from YIN/MPM describe the window as a whole, so the window
+     * centre is the best point to align them to the input stream.
+     *
+     * Real-time safe: No allocations.
+     */
+    class FrameClock
+    {
+    public:
+        /**
+         * @brief Constructs frame clock
+         * @param config Clock configuration
+         */
+        explicit FrameClock(const FrameClockConfig &config = FrameClockConfig{});
+
+        /**
+         * @brief Returns stamp of the next frame and advances by one hop
+         */
+        FrameStamp NextFrame();
+
+        /**
+         * @brief Stamps a result with the next frame and advances by one hop
+         * @param result Detection result for the next frame
+         */
+        TimedPitchResult Stamp(const PitchResult &result);
+
+        /**
+         * @brief Returns stamp of frame at hop index without advancing
+         * @param hopIndex Zero-based frame counter
+         */
+        [[nodiscard]] FrameStamp GetFrame(uint64_t hopIndex) const;
+
+        /**
+         * @brief Converts stream position in samples to seconds
+         */
+        [[nodiscard]] double ToSeconds(double samplePosition) const;
+
+        /**
+         * @brief Resets clock so the next frame starts at startSample
+         * @param startSample Stream index of first sample of the next frame
+         */
+        void Reset(uint64_t startSample = 0);
+
+    private:
+        FrameClockConfig config; ///< Clock configuration
+        uint64_t startSample;    ///< Stream index of frame 0
+        uint64_t nextHop;        ///< Hop index of the next frame
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file GuitarDspCApi.h
+ * @brief Stable C ABI for plugin hosts and foreign function interfaces
+ *
+ * All objects are opaque handles created and destroyed through this API.
+ * Configuration structs carry their own size so fields can be appended in
+ * later versions without breaking existing callers: always initialise them
+ * with the matching *_config_init() function before changing fields.
+ *
+ * Batched entry points (*_process_frames, gdsp_stabilizer_update with
+ * count > 1) process many frames per call to keep FFI crossing costs low.
+ *
+ * Functions never throw. Process functions are real-time safe under the
+ * same conditions as the wrapped C++ classes; create functions allocate.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(GUITAR_DSP_C_API_EXPORTS)
+#define GDSP_API __declspec(dllexport)
+#elif defined(GUITAR_DSP_C_API_SHARED)
+#define GDSP_API __declspec(dllimport)
+#else
+#define GDSP_API
+#endif
+#else
+#define GDSP_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief ABI version, incremented on incompatible changes */
+#define GDSP_ABI_VERSION 1
+
+/**
+ * @brief Status codes returned by process functions
+ */
+typedef enum gdsp_status
+{
+    GDSP_OK = 0,                      /**< Success */
+    GDSP_NO_PITCH = 1,                /**< Processed, but no pitch was detected */
+    GDSP_ERROR_INVALID_ARGUMENT = -1, /**< Null handle or pointer, or invalid size */
+    GDSP_ERROR_BUFFER_TOO_SMALL = -2, /**< Output buffer cannot hold the results */
+    GDSP_ERROR_INTERNAL = -3          /**< Unexpected internal failure */
+} gdsp_status;
+
+/**
+ * @brief Pitch detection algorithm
+ */
+typedef enum gdsp_detector_type
+{
+    GDSP_DETECTOR_YIN = 0,   /**< YinPitchDetector */
+    GDSP_DETECTOR_MPM = 1,   /**< MpmPitchDetector */
+    GDSP_DETECTOR_HYBRID = 2 /**< HybridPitchDetector */
+} gdsp_detector_type;
+
+/**
+ * @brief Pitch stabilization strategy
+ */
+typedef enum gdsp_stabilizer_type
+{
+    GDSP_STABILIZER_EMA = 0,    /**< ExponentialMovingAverage */
+    GDSP_STABILIZER_MEDIAN = 1, /**< MedianFilter */
+    GDSP_STABILIZER_HYBRID = 2  /**< HybridStabilizer */
+} gdsp_stabilizer_type;
+
+/**
+ * @brief Pitch result
+ */
+typedef struct gdsp_pitch_result
+{
+    float frequency;  /**< Detected frequency (Hz), 0 if not valid */
+    float confidence; /**< Confidence [0.0, 1.0] */
+    int32_t valid;    /**< Non-zero if a pitch was detected */
+} gdsp_pitch_result;
+
+/**
+ * @brief Detector configuration (initialise with gdsp_detector_config_init)
+ *
+ * For GDSP_DETECTOR_HYBRID, min_frequency and max_frequency apply to the
+ * MPM half only; its YIN half always searches 80 to 1200 Hz with threshold
+ * 0.10, and threshold is the YIN confidence above which the YIN estimate
+ * is used instead of MPM (HybridPitchDetectorConfig::yinConfidenceThreshold).
+ */
+typedef struct gdsp_detector_config
+{
+    uint32_t struct_size;     /**< sizeof(gdsp_detector_config) */
+    gdsp_detector_type type;  /**< Algorithm */
+    float min_frequency;      /**< Minimum detectable frequency (Hz) */
+    float max_frequency;      /**< Maximum detectable frequency (Hz) */
+    float threshold;          /**< Algorithm threshold (HYBRID: YIN confidence), 0 for the default */
+    uint32_t max_buffer_size; /**< Largest frame passed to process (pre-allocated) */
+} gdsp_detector_config;
+
+/**
+ * @brief Stabilizer configuration (initialise with gdsp_stabilizer_config_init)
+ */
+typedef struct gdsp_stabilizer_config
+{
+    uint32_t struct_size;      /**< sizeof(gdsp_stabilizer_config) */
+    gdsp_stabilizer_type type; /**< Strategy */
+    float alpha;               /**< EMA alpha (EMA and hybrid) */
+    uint32_t window_size;      /**< Median window size (median and hybrid) */
+} gdsp_stabilizer_config;
+
+typedef struct gdsp_detector gdsp_detector;     /**< Opaque pitch detector */
+typedef struct gdsp_stabilizer gdsp_stabilizer; /**< Opaque pitch stabilizer */
+typedef struct gdsp_fft gdsp_fft;               /**< Opaque FFT processor */
+
+/** @brief Returns GDSP_ABI_VERSION the library was built with */
+GDSP_API uint32_t gdsp_get_abi_version(void);
+
+/* Detectors */
+
+/** @brief Fills config with defaults for the given algorithm */
+GDSP_API void gdsp_detector_config_init(gdsp_detector_config *config, gdsp_detector_type type);
+
+/** @brief Creates detector, returns NULL on invalid config or allocation failure */
+GDSP_API gdsp_detector *gdsp_detector_create(const gdsp_detector_config *config);
+
+/** @brief Destroys detector (NULL is ignored) */
+GDSP_API void gdsp_detector_destroy(gdsp_detector *detector);
+
+/** @brief Resets detector state and last result */
+GDSP_API void gdsp_detector_reset(gdsp_detector *detector);
+
+/**
+ * @brief Detects pitch in one frame
+ * @param result Receives the result (may be NULL; see gdsp_detector_get_result)
+ * @return GDSP_OK, GDSP_NO_PITCH or an error
+ */
+GDSP_API gdsp_status gdsp_detector_process(gdsp_detector *detector,
+    const float *samples,
+    size_t sample_count,
+    float sample_rate,
+    gdsp_pitch_result *result);
+
+/**
+ * @brief Detects pitch in every frame of a signal in one call
+ *
+ * Frame k covers samples [k * hop_size, k * hop_size + frame_size).
+ * Frames without a pitch have valid == 0.
+ *
+ * @param results Output array, one entry per frame
+ * @param max_results Capacity of results
+ * @param frames_written Receives the number of frames processed (may be NULL)
+ * @return GDSP_OK, GDSP_ERROR_BUFFER_TOO_SMALL if not all frames fit (the
+ *         frames that fit are still processed), or an error
+ */
+GDSP_API gdsp_status gdsp_detector_process_frames(gdsp_detector *detector,
+    const float *signal,
+    size_t signal_length,
+    size_t frame_size,
+    size_t hop_size,
+    float sample_rate,
+    gdsp_pitch_result *results,
+    size_t max_results,
+    size_t *frames_written);
+
+/** @brief Returns the result of the most recent processed frame */
+GDSP_API gdsp_status gdsp_detector_get_result(const gdsp_detector *detector, gdsp_pitch_result *result);
+
+/* Stabilizers */
+
+/** @brief Fills config with defaults for the given strategy */
+GDSP_API void gdsp_stabilizer_config_init(gdsp_stabilizer_config *config, gdsp_stabilizer_type type);
+
+/** @brief Creates stabilizer, returns NULL on invalid config or allocation failure */
+GDSP_API gdsp_stabilizer *gdsp_stabilizer_create(const gdsp_stabilizer_config *config);
+
+/** @brief Destroys stabilizer (NULL is ignored) */
+GDSP_API void gdsp_stabilizer_destroy(gdsp_stabilizer *stabilizer);
+
+/** @brief Resets stabilizer state */
+GDSP_API void gdsp_stabilizer_reset(gdsp_stabilizer *stabilizer);
+
+/**
+ * @brief Feeds a sequence of results to the stabilizer
+ *
+ * Entries with valid == 0 are skipped.
+ *
+ * @param stabilized Receives the stabilized value after each input (may be NULL)
+ */
+GDSP_API gdsp_status gdsp_stabilizer_update(gdsp_stabilizer *stabilizer,
+    const gdsp_pitch_result *results,
+    size_t count,
+    gdsp_pitch_result *stabilized);
+
+/** @brief Returns the current stabilized value */
+GDSP_API gdsp_status gdsp_stabilizer_get_result(const gdsp_stabilizer *stabilizer, gdsp_pitch_result *result);
+
+/** @brief Returns stabilizer group delay in frames */
+GDSP_API float gdsp_stabilizer_get_group_delay(const gdsp_stabilizer *stabilizer);
+
+/* FFT */
+
+/** @brief Creates FFT processor, returns NULL on invalid size or allocation failure */
+GDSP_API gdsp_fft *gdsp_fft_create(size_t fft_size, float sample_rate);
+
+/** @brief Destroys FFT processor (NULL is ignored) */
+GDSP_API void gdsp_fft_destroy(gdsp_fft *fft);
+
+/** @brief Returns number of magnitude bins per spectrum (fft_size / 2) */
+GDSP_API size_t gdsp_fft_get_bin_count(const gdsp_fft *fft);
+
+/** @brief Computes spectrum of one frame (uses the first fft_size samples, zero-pads shorter input) */
+GDSP_API gdsp_status gdsp_fft_process(gdsp_fft *fft, const float *samples, size_t sample_count);
+
+/** @brief Copies magnitudes of the most recent spectrum (bin_count entries) */
+GDSP_API gdsp_status gdsp_fft_get_magnitudes(const gdsp_fft *fft, float *magnitudes, size_t bin_count);
+
+/**
+ * @brief Computes magnitude spectra of every frame of a signal in one call
+ *
+ * Frame k covers samples [k * hop_size, k * hop_size + fft_size) and its
+ * magnitudes are written to magnitudes[k * bin_count, (k + 1) * bin_count).
+ *
+ * @param max_frames Capacity of magnitudes in frames
+ * @param frames_written Receives the number of frames processed (may be NULL)
+ */
+GDSP_API gdsp_status gdsp_fft_process_frames(gdsp_fft *fft,
+    const float *signal,
+    size_t signal_length,
+    size_t hop_size,
+    float *magnitudes,
+    size_t max_frames,
+    size_t *frames_written);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "FFTProcessor.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Configuration for inharmonicity estimator
+     */
+    struct InharmonicityEstimatorConfig
+    {
+        uint32_t maxPartials = 16;          ///< Maximum number of partials to locate
+        uint32_t minPartials = 4;           ///< Minimum partials required for a valid fit
+        uint32_t iterations = 3;            ///< Partial search / least-squares refinement passes
+        float searchToleranceCents = 40.0f; ///< Peak search half-width around predicted partial (cents)
+        float minRelativeMagnitude = 0.01f; ///< Minimum partial magnitude relative to strongest partial
+        float maxInharmonicity = 0.01f;     ///< Upper bound for coefficient B (wound strings ~1e-5..1e-3)
+        float maxFrequency = 8000.0f;       ///< Partials above this frequency are ignored (Hz)
+    };
+
+    /**
+     * @brief Single detected partial
+     */
+    struct Partial
+    {
+        uint32_t number; ///< Partial number n (1 = fundamental)
+        float frequency; ///< Measured partial frequency (Hz)
+        float magnitude; ///< Interpolated peak magnitude
+    };
+
+    /**
+     * @brief Result of joint fundamental / inharmonicity fit
+     */
+    struct InharmonicityResult
+    {
+        float fundamental;     ///< Fitted fundamental f0 (Hz)
+        float inharmonicity;   ///< Fitted inharmonicity coefficient B
+        uint32_t partialCount; ///< Number of partials used in the fit
+        float residualCents;   ///< RMS residual of the fitted partials (cents)
+    };
+
+    /**
+     * @brief Inharmonicity-aware fundamental estimator for stiff strings
+     *
+     * Stiff strings have partials stretched sharp of the harmonic series:
+     * f_n = n * f0 * sqrt(1 + B * n^2)
+     *
+     * Given a spectrum and a coarse f0 (e.g. from YIN), the estimator locates
+     * partials around their predicted positions and fits f0 and B jointly.
+     * Squaring the model gives (f_n / n)^2 = f0^2 + f0^2 * B * n^2, which is
+     * linear in n^2, so each pass is a closed-form weighted least-squares fit.
+     * Predicted positions are refined with the new B on every pass.
+     *
+     * Real-time safe: Partial table is pre-allocated in constructor.
+     */
+    class InharmonicityEstimator
+    {
+    public:
+        /**
+         * @brief Constructs inharmonicity estimator
+         * @param config Estimator configuration
+         */
+        explicit InharmonicityEstimator(const InharmonicityEstimatorConfig &config = InharmonicityEstimatorConfig{});
+
+        /**
+         * @brief Fits fundamental and inharmonicity from spectrum
+         * @param spectrum Spectrum of the analysed frame
+         * @param coarseFundamental Initial fundamental estimate (Hz)
+         * @return Fit result if enough partials were found, nullopt otherwise
+         */
+        [[nodiscard]] std::optional<InharmonicityResult> Estimate(const FFTSpectrum &spectrum, float coarseFundamental);
+
+        /**
+         * @brief Returns partials used by the most recent successful fit
+         */
+        [[nodiscard]] std::span<const Partial> GetPartials() const;
+
+        /**
+         * @brief Resets internal state
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Locates partials around positions predicted by (f0, B)
+         * @return Number of partials found
+         */
+        uint32_t LocatePartials(const FFTSpectrum &spectrum, float fundamental, float inharmonicity);
+
+        /**
+         * @brief Finds interpolated spectral peak near frequency
+         * @return True if a local maximum was found inside the search range
+         */
+        bool FindPeak(const FFTSpectrum &spectrum, float frequency, float &peakFrequency, float &peakMagnitude) const;
+
+        InharmonicityEstimatorConfig config; ///< Estimator configuration
+        std::vector<Partial> partials;       ///< Detected partials (pre-allocated)
+        uint32_t partialCount;               ///< Number of valid entries in partials
+    };
+
+} // namespace GuitarDSP
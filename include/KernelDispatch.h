@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CpuFeatures.h"
+#include <cstddef>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Float kernels compiled once per ISA level
+     *
+     * The plain summing kernels accumulate in float and return the sum
+     * widened to double, matching the FloatAccumulation policy. The Double
+     * variants evaluate terms and sums in double (DoubleAccumulation); the
+     * Compensated variants form terms in float and add them with per-lane
+     * Kahan compensation (CompensatedAccumulation).
+     */
+    struct KernelTable
+    {
+        IsaLevel level; ///< ISA level the kernels were compiled for
+
+        /// sum(a[i] * b[i]) over count elements
+        double (*dotProduct)(const float *a, const float *b, size_t count);
+
+        /// sum((a[i] - b[i])^2) over count elements
+        double (*squaredDifferenceSum)(const float *a, const float *b, size_t count);
+
+        /// sum(a[i]^2) over count elements
+        double (*sumOfSquares)(const float *a, size_t count);
+
+        /// magnitudes[i] = |interleaved[2i] + j * interleaved[2i + 1]| for count complex values
+        void (*complexMagnitude)(const float *interleaved, float *magnitudes, size_t count);
+
+        /// sum(a[i]) over count elements
+        double (*sum)(const float *a, size_t count);
+
+        /// max(a[i]) over count elements (-infinity for count == 0)
+        float (*maximum)(const float *a, size_t count);
+
+        /// dotProduct with terms and sums in double
+        double (*dotProductDouble)(const float *a, const float *b, size_t count);
+
+        /// squaredDifferenceSum with terms and sums in double
+        double (*squaredDifferenceSumDouble)(const float *a, const float *b, size_t count);
+
+        /// sumOfSquares with terms and sums in double
+        double (*sumOfSquaresDouble)(const float *a, size_t count);
+
+        /// dotProduct with Kahan-compensated float sums
+        double (*dotProductCompensated)(const float *a, const float *b, size_t count);
+
+        /// squaredDifferenceSum with Kahan-compensated float sums
+        double (*squaredDifferenceSumCompensated)(const float *a, const float *b, size_t count);
+
+        /// sumOfSquares with Kahan-compensated float sums
+        double (*sumOfSquaresCompensated)(const float *a, size_t count);
+    };
+
+    /**
+     * @brief Returns kernels for the active ISA level
+     *
+     * Real-time safe after the first call: selection runs once (CPUID and an
+     * environment lookup, no allocation), later calls are a single atomic load.
+     */
+    [[nodiscard]] const KernelTable &GetKernels();
+
+} // namespace GuitarDSP
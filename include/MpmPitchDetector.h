@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AccumulationPolicy.h"
 #include "PitchDetector.h"
 #include <memory>
 #include <vector>
@@ -11,11 +12,14 @@ namespace GuitarDSP
      */
     struct MpmPitchDetectorConfig
     {
-        float threshold = 0.93f;      ///< NSDF threshold [0.0, 1.0] (higher = more selective)
-        float minFrequency = 80.0f;   ///< Minimum detectable frequency (Hz)
-        float maxFrequency = 1200.0f; ///< Maximum detectable frequency (Hz)
-        float cutoff = 0.97f;         ///< Cutoff for peak detection
-        float smallCutoff = 0.5f;     ///< Small cutoff for initial peak search
+        float threshold = 0.93f;                                        ///< NSDF threshold [0.0, 1.0]
+        float minFrequency = 80.0f;                                     ///< Minimum detectable frequency (Hz)
+        float maxFrequency = 1200.0f;                                   ///< Maximum detectable frequency (Hz)
+        float cutoff = 0.97f;                                           ///< Cutoff for peak detection
+        float smallCutoff = 0.5f;                                       ///< Small cutoff for initial peak search
+        AccumulationPrecision precision = AccumulationPrecision::Float; ///< Correlation and normalisation precision
+        size_t maxBufferSize = 4096;                                    ///< Largest input buffer (pre-allocated)
+        bool lazyEvaluation = false;                                    ///< Stop at the first accepted key maximum
     };
 
 
@@ -25,6 +29,15 @@ namespace GuitarDSP
      * Based on "A Smarter Way to Find Pitch" by Philip McLeod (2005)
      * Uses NSDF (Normalized Square Difference Function) for robust pitch detection,
      * particularly effective for signals with vibrato or changing pitch.
+     *
+     * With config.lazyEvaluation NSDF lags are computed in order and
+     * evaluation stops at the first key maximum (highest point between a
+     * positive-going and the next negative-going zero crossing) that reaches
+     * both threshold and cutoff times the largest key maximum seen so far.
+     * Key maxima below smallCutoff are ignored. Only lags up to the period
+     * of minFrequency are searched, so high notes skip most of the range.
+     *
+     * Real-time safe: Buffers are pre-allocated for config.maxBufferSize.
      */
     class MpmPitchDetector : public PitchDetector
     {
@@ -44,13 +57,24 @@ namespace GuitarDSP
     private:
         /**
          * @brief Computes Normalized Square Difference Function (NSDF)
+         * @tparam Policy Accumulation policy (see AccumulationPolicy.h)
          */
+        template<typename Policy>
         void ComputeNSDF(std::span<const float> buffer);
 
         /**
-         * @brief Finds peaks in NSDF above threshold
+         * @brief Computes NSDF in lag order up to the first accepted key maximum
+         * @tparam Policy Accumulation policy (see AccumulationPolicy.h)
+         * @return Lag of the key maximum, or -1 if none qualifies
+         */
+        template<typename Policy>
+        int FindKeyMaximumLazy(std::span<const float> buffer, size_t maxTau);
+
+        /**
+         * @brief Finds highest NSDF peak above threshold
+         * @return Lag of the peak, or -1 if no peak qualifies
          */
-        std::vector<int> FindPeaks();
+        [[nodiscard]] int FindBestPeak() const;
 
         /**
          * @brief Uses parabolic interpolation to refine peak position
@@ -61,6 +85,7 @@ namespace GuitarDSP
         std::vector<float> nsdfBuffer; ///< NSDF values
         std::vector<float> acfBuffer;  ///< Autocorrelation buffer
         std::vector<float> rBuffer;    ///< Temp buffer for ACF calculation
+        size_t nsdfSize;               ///< Number of valid lags for current buffer
     };
 
 } // namespace GuitarDSP
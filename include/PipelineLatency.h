@@ -0,0 +1,59 @@
+#pragma once
+
+#include "PitchStabilizer.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Description of an analysis pipeline for latency accounting
+     *
+     * All delays are expressed in input-rate samples.
+     */
+    struct PipelineLatencyConfig
+    {
+        float sampleRate = 48000.0f;                 ///< Input sample rate (Hz)
+        size_t windowSize = 4096;                    ///< Analysis window length (input samples)
+        size_t hopSize = 512;                        ///< Samples between consecutive frames
+        float prefilterGroupDelay = 0.0f;            ///< Group delay of any pre-filter (samples)
+        uint32_t decimationFactor = 1;               ///< Decimation factor ahead of the detector (1 = none)
+        float decimatorGroupDelay = 0.0f;            ///< Group delay of the decimation filter (samples)
+        const PitchStabilizer *stabilizer = nullptr; ///< Optional stabilizer applied per frame
+    };
+
+    /**
+     * @brief Algorithmic latency breakdown of a pipeline
+     *
+     * Delays are measured from the moment a sound enters the stream to the
+     * moment it dominates the reported pitch, excluding compute time.
+     */
+    struct LatencyReport
+    {
+        float windowDelay;       ///< Newest sample to window centre (samples)
+        float hopDelay;          ///< Worst-case wait for the next frame boundary (samples)
+        float prefilterDelay;    ///< Pre-filter group delay (samples)
+        float decimatorDelay;    ///< Decimation filter group delay (samples)
+        float stabilizerDelay;   ///< Stabilizer group delay (samples)
+        float totalSamples;      ///< Sum of all delays (samples)
+        float totalMilliseconds; ///< Sum of all delays (ms)
+    };
+
+    /**
+     * @brief Algorithmic latency accounting for detector pipelines
+     *
+     * Lets configurations (window, hop, filtering, stabilization) be compared
+     * for end-to-end latency before running them.
+     */
+    class PipelineLatency
+    {
+    public:
+        /**
+         * @brief Computes algorithmic latency of a pipeline
+         * @param config Pipeline description
+         * @return Latency breakdown
+         */
+        [[nodiscard]] static LatencyReport Compute(const PipelineLatencyConfig &config);
+    };
+
+} // namespace GuitarDSP
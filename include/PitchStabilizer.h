@@ -35,6 +35,19 @@ namespace GuitarDSP
          * @brief Resets internal state
          */
         virtual void Reset() = 0;
+
+        /**
+         * @brief Gets nominal group delay of the smoothing
+         *
+         * Not pure so existing subclasses keep compiling; the built-in
+         * stabilizers override it.
+         *
+         * @return Group delay in update periods (frames), 0 if not reported
+         */
+        [[nodiscard]] virtual float GetGroupDelay() const
+        {
+            return 0.0f;
+        }
     };
 
     /**
@@ -69,6 +82,8 @@ namespace GuitarDSP
 
         void Reset() override;
 
+        [[nodiscard]] float GetGroupDelay() const override;
+
     private:
         EMAConfig config;       ///< Stabilizer configuration
         PitchResult stabilized; ///< Current stabilized result
@@ -92,6 +107,9 @@ namespace GuitarDSP
      * Window size affects smoothing:
      * Smaller window → less smoothing, faster response
      * Larger window → more smoothing, better spike rejection
+     *
+     * The median is computed in Update() and cached; GetStabilized() only
+     * reads it, so concurrent readers are safe while no Update() runs.
      */
     class MedianFilter : public PitchStabilizer
     {
@@ -108,13 +126,18 @@ namespace GuitarDSP
 
         void Reset() override;
 
-    private:
-        MedianFilterConfig config;       ///< Stabilizer configuration
-        std::vector<PitchResult> window; ///< Circular buffer (pre-allocated)
-        uint32_t writeIndex;             ///< Current write position
-        uint32_t sampleCount;            ///< Number of samples in buffer
+        [[nodiscard]] float GetGroupDelay() const override;
 
-        [[nodiscard]] PitchResult ComputeMedian() const;
+    private:
+        MedianFilterConfig config;            ///< Stabilizer configuration
+        std::vector<PitchResult> window;      ///< Circular buffer (pre-allocated)
+        std::vector<float> frequencyScratch;  ///< Sort scratch for frequencies (pre-allocated)
+        std::vector<float> confidenceScratch; ///< Sort scratch for confidences (pre-allocated)
+        PitchResult median;                   ///< Median of the window after the last Update()
+        uint32_t writeIndex;                  ///< Current write position
+        uint32_t sampleCount;                 ///< Number of samples in buffer
+
+        [[nodiscard]] PitchResult ComputeMedian();
     };
 
     /**
@@ -153,6 +176,8 @@ namespace GuitarDSP
 
         void Reset() override;
 
+        [[nodiscard]] float GetGroupDelay() const override;
+
     private:
         [[nodiscard]] float ComputeAdaptiveAlpha(float confidence) const;
 
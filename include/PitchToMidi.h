@@ -0,0 +1,261 @@
+#pragma once
+
+#include "ProgressivePitchDetector.h"
+#include "YinPitchDetector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Kind of MIDI event produced by PitchToMidi
+     */
+    enum class MidiEventType : uint8_t
+    {
+        NoteOn,   ///< note and velocity valid
+        NoteOff,  ///< note valid
+        PitchBend ///< bend valid (sent before NoteOn and while a note sounds)
+    };
+
+    /**
+     * @brief Channel voice event stamped with its stream position
+     */
+    struct MidiEvent
+    {
+        uint64_t position;  ///< Stream index at which the event was decided
+        uint32_t latency;   ///< Samples from the note's onset to position
+        MidiEventType type; ///< Event kind
+        uint8_t channel;    ///< MIDI channel (0-15)
+        uint8_t note;       ///< MIDI note number
+        uint8_t velocity;   ///< Note-on velocity (1-127)
+        int16_t bend;       ///< Pitch bend [-8192, 8191], 0 = centre
+    };
+
+    /**
+     * @brief Fixed-capacity lock-free single-producer single-consumer event queue
+     *
+     * The producer (audio thread) pushes, the consumer (same thread or a
+     * MIDI output thread) pops. Events that do not fit are dropped and
+     * counted. Real-time safe: no allocation after construction.
+     */
+    class MidiEventQueue
+    {
+    public:
+        /**
+         * @brief Constructs queue
+         * @param capacity Events held (rounded up to a power of 2)
+         */
+        explicit MidiEventQueue(size_t capacity);
+
+        MidiEventQueue(const MidiEventQueue &) = delete;
+        MidiEventQueue &operator=(const MidiEventQueue &) = delete;
+        MidiEventQueue(MidiEventQueue &&) = delete;
+        MidiEventQueue &operator=(MidiEventQueue &&) = delete;
+
+        /**
+         * @brief Producer: appends event
+         * @return False if the queue is full (event dropped)
+         */
+        bool Push(const MidiEvent &event);
+
+        /**
+         * @brief Consumer: takes the oldest event
+         * @return False if the queue is empty
+         */
+        bool Pop(MidiEvent &event);
+
+        /**
+         * @brief Consumer: takes events, oldest first
+         * @param events Output events
+         * @return Number of events written
+         */
+        size_t Drain(std::span<MidiEvent> events);
+
+        /**
+         * @brief Returns number of events dropped on a full queue
+         */
+        [[nodiscard]] uint64_t GetDroppedCount() const;
+
+    private:
+        std::vector<MidiEvent> events;                  ///< Event ring
+        size_t mask;                                    ///< Ring size - 1
+        alignas(64) std::atomic<size_t> writeIndex;     ///< Events pushed (producer)
+        alignas(64) std::atomic<size_t> readIndex;      ///< Events popped (consumer)
+        alignas(64) std::atomic<uint64_t> droppedCount; ///< Events dropped (producer)
+    };
+
+    /**
+     * @brief Measured onset-to-note-on latency
+     */
+    struct MidiLatencyStatistics
+    {
+        uint64_t noteCount;   ///< Note-ons emitted
+        uint32_t lastSamples; ///< Latency of the most recent note-on (samples)
+        uint32_t maxSamples;  ///< Largest latency (samples)
+        double meanSamples;   ///< Mean latency (samples)
+        uint64_t overBudget;  ///< Note-ons later than latencyBudgetMs
+    };
+
+    /**
+     * @brief Configuration for pitch-to-MIDI conversion
+     */
+    struct PitchToMidiConfig
+    {
+        float sampleRate = 48000.0f;      ///< Sample rate (Hz)
+        uint8_t channel = 0;              ///< MIDI channel of all events (0-15)
+        float a4Frequency = 440.0f;       ///< Tuning reference (Hz)
+        float minFrequency = 70.0f;       ///< Lowest note tracked (Hz)
+        float maxFrequency = 1400.0f;     ///< Highest note tracked (Hz)
+        size_t blockSize = 64;            ///< Onset detection block; windows and hops are multiples of it
+        size_t minWindow = 128;           ///< Samples after an onset before the first estimate
+        size_t maxWindow = 2048;          ///< Full window the progressive estimate grows to (samples)
+        size_t hopSize = 256;             ///< Samples between estimates after the window has grown
+        float onsetRatio = 4.0f;          ///< Block energy over slow average that marks an onset
+        float onsetGateDb = -45.0f;       ///< Minimum block level for an onset (dBFS)
+        float releaseGateDb = -55.0f;     ///< Note-off below this level (dBFS)
+        float releaseDropDb = 36.0f;      ///< Note-off this far below the note's peak level
+        float threshold = 0.12f;          ///< YIN threshold of the estimates
+        float hysteresisCents = 70.0f;    ///< Deviation from the held note before it may change
+        uint32_t noteChangeEstimates = 2; ///< Consecutive estimates needed to change note
+        float pitchBendRange = 2.0f;      ///< Synth bend range (semitones)
+        int32_t pitchBendStep = 64;       ///< Smallest bend change sent (of 8192)
+        float latencyBudgetMs = 12.0f;    ///< Note-ons later than this are counted as over budget
+        size_t queueCapacity = 256;       ///< Event queue size
+    };
+
+    /**
+     * @brief Low-latency conversion of a guitar signal to MIDI note and bend events
+     *
+     * An energy onset detector on short blocks marks each pluck. From the
+     * onset on, a ProgressivePitchDetector re-estimates at every block on a
+     * window that starts at the onset and grows to maxWindow, reusing the
+     * difference sums of the previous block. High notes are recognised
+     * after about two periods, low notes as soon as two of their periods
+     * have arrived. The first confident estimate emits the note-on,
+     * preceded by the bend for its cent offset.
+     *
+     * Once the window is full, estimates continue every hopSize with lazy
+     * YIN on the newest maxWindow samples. The note is locked: deviations
+     * up to hysteresisCents only move the pitch bend, larger ones must
+     * persist for noteChangeEstimates estimates before the note changes
+     * (legato). A new onset or a level drop below the release gate ends
+     * the note.
+     *
+     * Every note-on carries its onset-to-decision latency in samples; the
+     * statistics compare it with latencyBudgetMs.
+     *
+     * Real-time safe: Process() does not allocate.
+     */
+    class PitchToMidi
+    {
+    public:
+        /**
+         * @brief Constructs converter and pre-allocates history, detectors and queue
+         * @param config Converter configuration
+         */
+        explicit PitchToMidi(const PitchToMidiConfig &config = PitchToMidiConfig{});
+
+        PitchToMidi(const PitchToMidi &) = delete;
+        PitchToMidi &operator=(const PitchToMidi &) = delete;
+        PitchToMidi(PitchToMidi &&) = delete;
+        PitchToMidi &operator=(PitchToMidi &&) = delete;
+
+        /**
+         * @brief Analyses the next block of input and queues resulting events
+         * @param input Next block of the input stream (any length)
+         */
+        void Process(std::span<const float> input);
+
+        /**
+         * @brief Returns event queue (consumer side may live on another thread)
+         */
+        MidiEventQueue &GetEvents();
+
+        /**
+         * @brief Returns onset-to-note-on latency statistics
+         */
+        [[nodiscard]] MidiLatencyStatistics GetLatencyStatistics() const;
+
+        /**
+         * @brief Returns currently sounding note, -1 if none
+         */
+        [[nodiscard]] int32_t GetActiveNote() const;
+
+        /**
+         * @brief Queues note-off for a sounding note and clears all state
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Conversion state between onsets
+         */
+        enum class State
+        {
+            Idle,    ///< No note, waiting for an onset
+            Pending, ///< Onset seen, no confident estimate yet
+            Sounding ///< Note-on sent
+        };
+
+        /**
+         * @brief Handles a completed onset block
+         */
+        void EndBlock(float blockEnergy);
+
+        /**
+         * @brief Runs the estimate due after the block ending at the current position
+         */
+        void Estimate();
+
+        /**
+         * @brief Applies an estimate to the note state
+         */
+        void ApplyEstimate(float midiNote);
+
+        /**
+         * @brief Queues note-off for the active note
+         */
+        void ReleaseNote();
+
+        /**
+         * @brief Queues bend (if needed) and note-on
+         */
+        void StartNote(int32_t note, float midiNote);
+
+        /**
+         * @brief Queues pitch bend for deviation of midiNote from the active note if it moved enough
+         */
+        void UpdateBend(float midiNote, bool force);
+
+        /**
+         * @brief Queues event of given type at the current position
+         */
+        void Emit(MidiEventType type, uint8_t note, uint8_t velocity, int16_t bend);
+
+        PitchToMidiConfig config;             ///< Converter configuration
+        ProgressivePitchDetector progressive; ///< Onset-anchored growing window
+        YinPitchDetector tracker;             ///< Hop estimates once the window is full
+        MidiEventQueue events;                ///< Output events
+        std::vector<float> history;           ///< Mirrored input ring, 2 * maxWindow
+        size_t writeIndex;                    ///< Next write position in history
+        uint64_t position;                    ///< Samples received
+        size_t blockFill;                     ///< Samples in the current onset block
+        float blockEnergy;                    ///< Sum of squares of the current block
+        float slowEnergy;                     ///< Slow average of block mean square
+        float onsetEnergy;                    ///< Smallest block mean square for an onset
+        float releaseEnergy;                  ///< Block mean square below which notes end
+        State state;                          ///< Conversion state
+        uint64_t onsetPosition;               ///< Stream index of the last onset
+        uint64_t nextEstimate;                ///< Position of the next hop estimate
+        float peakEnergy;                     ///< Loudest block mean square since onset
+        int32_t activeNote;                   ///< Sounding note, -1 if none
+        int32_t candidateNote;                ///< Note competing with activeNote
+        uint32_t candidateCount;              ///< Consecutive estimates of candidateNote
+        int32_t lastBend;                     ///< Last bend sent
+        MidiLatencyStatistics latency;        ///< Note-on latency statistics
+    };
+
+} // namespace GuitarDSP
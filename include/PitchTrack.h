@@ -0,0 +1,184 @@
+#pragma once
+
+#include "PitchDetector.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Single timestamped pitch track entry
+     */
+    struct PitchTrackEntry
+    {
+        uint64_t timestamp; ///< Timestamp in ticks (see PitchTrackConfig::timeBase)
+        PitchResult result; ///< Pitch result (quantized on write)
+    };
+
+    /**
+     * @brief Index record for one pitch track chunk
+     */
+    struct PitchTrackChunkIndex
+    {
+        uint64_t offset;         ///< Chunk offset from start of track
+        uint64_t firstTimestamp; ///< Timestamp of first entry
+        uint64_t lastTimestamp;  ///< Timestamp of last entry
+        uint32_t entryCount;     ///< Number of entries
+    };
+
+    /**
+     * @brief Configuration for pitch track encoding
+     */
+    struct PitchTrackConfig
+    {
+        float timeBase = 48000.0f;       ///< Ticks per second (sample rate for sample-position timestamps)
+        float centsResolution = 0.1f;    ///< Pitch quantization step (cents, at least 0.001)
+        uint32_t entriesPerChunk = 1024; ///< Entries per independently decodable chunk
+        uint32_t expectedChunks = 1024;  ///< Index capacity reserved up front
+    };
+
+    /**
+     * @brief Streaming writer for compact binary pitch tracks
+     *
+     * Layout (little-endian):
+     * - Header: magic "GPTK", version, time base, cents resolution
+     * - Chunks: entry count, payload size, first timestamp, then per entry
+     *   varint timestamp delta, zigzag varint quantized-cents delta relative
+     *   to A4 and 8-bit confidence
+     * - Index: per chunk file offset and time range, followed by the index
+     *   offset and magic "GPTI"
+     *
+     * Every chunk restarts delta coding, so readers can seek by time through
+     * the index and decode a single chunk.
+     *
+     * Append() encodes into a pre-allocated chunk buffer without
+     * allocating, but the Append() that completes a chunk flushes it to the
+     * stream and blocks on it; index growth past expectedChunks allocates.
+     * Hand results to a non-real-time thread for writing.
+     */
+    class PitchTrackWriter
+    {
+    public:
+        /**
+         * @brief Constructs writer and emits file header
+         * @param stream Output stream (binary mode)
+         * @param config Encoding configuration
+         */
+        explicit PitchTrackWriter(std::ostream &stream, const PitchTrackConfig &config = PitchTrackConfig{});
+
+        /**
+         * @brief Finishes the track if Finish() was not called
+         */
+        ~PitchTrackWriter();
+
+        PitchTrackWriter(const PitchTrackWriter &) = delete;
+        PitchTrackWriter &operator=(const PitchTrackWriter &) = delete;
+        PitchTrackWriter(PitchTrackWriter &&) = delete;
+        PitchTrackWriter &operator=(PitchTrackWriter &&) = delete;
+
+        /**
+         * @brief Appends pitch result
+         * @param timestamp Timestamp in ticks (must be non-decreasing)
+         * @param result Pitch result (frequency must be finite and positive)
+         * @return False if entry was rejected or the stream failed
+         */
+        bool Append(uint64_t timestamp, const PitchResult &result);
+
+        /**
+         * @brief Flushes pending chunk and writes index and footer
+         * @return False if the stream failed
+         */
+        bool Finish();
+
+    private:
+        /**
+         * @brief Writes current chunk to stream and records it in the index
+         */
+        bool FlushChunk();
+
+        std::ostream &stream;                    ///< Output stream
+        PitchTrackConfig config;                 ///< Encoding configuration
+        std::vector<uint8_t> chunkBuffer;        ///< Encoded payload of current chunk (pre-allocated)
+        size_t chunkBytes;                       ///< Valid bytes in chunkBuffer
+        uint32_t chunkEntries;                   ///< Entries in current chunk
+        uint64_t chunkFirstTimestamp;            ///< First timestamp of current chunk
+        uint64_t previousTimestamp;              ///< Last appended timestamp
+        int32_t previousCents;                   ///< Last appended quantized pitch
+        uint64_t bytesWritten;                   ///< Bytes written to stream so far
+        std::vector<PitchTrackChunkIndex> index; ///< Chunk index (reserved up front)
+        bool finished;                           ///< Footer written
+    };
+
+    /**
+     * @brief Random-access reader for binary pitch tracks
+     *
+     * Loads the chunk index on construction and decodes chunks on demand.
+     * Not real-time safe: intended for offline analysis and tooling.
+     */
+    class PitchTrackReader
+    {
+    public:
+        /**
+         * @brief Constructs reader and loads index
+         * @param stream Input stream positioned at start of track (binary mode)
+         */
+        explicit PitchTrackReader(std::istream &stream);
+
+        PitchTrackReader(const PitchTrackReader &) = delete;
+        PitchTrackReader &operator=(const PitchTrackReader &) = delete;
+        PitchTrackReader(PitchTrackReader &&) = delete;
+        PitchTrackReader &operator=(PitchTrackReader &&) = delete;
+
+        /**
+         * @brief Returns true if header and index were read successfully
+         */
+        [[nodiscard]] bool IsValid() const;
+
+        /**
+         * @brief Returns time base of the track (ticks per second)
+         */
+        [[nodiscard]] float GetTimeBase() const;
+
+        /**
+         * @brief Returns total number of entries
+         */
+        [[nodiscard]] uint64_t GetEntryCount() const;
+
+        /**
+         * @brief Finds the latest entry at or before timestamp
+         * @param timestamp Timestamp in ticks
+         * @return Entry if one exists at or before timestamp, nullopt otherwise
+         */
+        [[nodiscard]] std::optional<PitchTrackEntry> FindAt(uint64_t timestamp);
+
+        /**
+         * @brief Reads all entries with timestamps in [begin, end)
+         * @param begin First timestamp (inclusive)
+         * @param end Last timestamp (exclusive)
+         * @param entries Output entries (appended)
+         * @return False if a chunk could not be decoded
+         */
+        bool ReadRange(uint64_t begin, uint64_t end, std::vector<PitchTrackEntry> &entries);
+
+    private:
+        /**
+         * @brief Decodes chunk into cachedEntries (no-op if already cached)
+         */
+        bool LoadChunk(size_t chunk);
+
+        std::istream &stream;                       ///< Input stream
+        std::streamoff origin;                      ///< Stream position of track start
+        float timeBase;                             ///< Ticks per second
+        float centsResolution;                      ///< Pitch quantization step (cents)
+        std::vector<PitchTrackChunkIndex> index;    ///< Chunk index
+        std::vector<PitchTrackEntry> cachedEntries; ///< Entries of most recently decoded chunk
+        std::vector<uint8_t> payload;               ///< Scratch buffer for chunk payload
+        size_t cachedChunk;                         ///< Index of cached chunk
+        bool valid;                                 ///< Header and index loaded
+    };
+
+} // namespace GuitarDSP
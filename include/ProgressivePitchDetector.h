@@ -0,0 +1,107 @@
+#pragma once
+
+#include "PitchDetector.h"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Configuration for progressive (onset-anchored) YIN
+     */
+    struct ProgressivePitchDetectorConfig
+    {
+        float threshold = 0.15f;      ///< Detection threshold [0.0, 1.0]
+        float minFrequency = 80.0f;   ///< Minimum detectable frequency (Hz)
+        float maxFrequency = 1200.0f; ///< Maximum detectable frequency (Hz)
+        size_t maxBufferSize = 4096;  ///< Full window after the onset (pre-allocated)
+    };
+
+    /**
+     * @brief YIN estimator whose window starts at an onset and grows to full size
+     *
+     * Reset() at an onset, then Push() the samples that follow and call
+     * Refine() whenever an estimate is wanted. Refine() runs YIN on all
+     * samples pushed so far: with N samples the difference function
+     * integrates N / 2 samples and searches lags below N / 2, so a note is
+     * found as soon as about two of its periods have arrived. Lags beyond
+     * the current window are simply not searched yet; a dip must turn
+     * upwards inside the window to be accepted, so the estimate is
+     * provisional but not cut off at the window edge.
+     *
+     * The window is anchored at the onset, so growing it from W to W' only
+     * adds the terms j in [W, W') to each existing lag's difference sum;
+     * only the new lags are computed from scratch. Refining every block up
+     * to maxBufferSize therefore costs about the same as one YIN evaluation
+     * of the full window. The sums are kept in double so the repeated
+     * additions do not drift.
+     *
+     * Detect() is Reset(), Push() and Refine() on one buffer.
+     *
+     * Real-time safe: Push() and Refine() do not allocate.
+     */
+    class ProgressivePitchDetector : public PitchDetector
+    {
+    public:
+        /**
+         * @brief Constructs detector and pre-allocates the window and difference sums
+         * @param config Algorithm configuration
+         */
+        explicit ProgressivePitchDetector(
+            const ProgressivePitchDetectorConfig &config = ProgressivePitchDetectorConfig{});
+
+        ~ProgressivePitchDetector() override;
+
+        [[nodiscard]] std::optional<PitchResult> Detect(std::span<const float> buffer, float sampleRate) override;
+
+        /**
+         * @brief Discards the window; call at each onset
+         */
+        void Reset() override;
+
+        /**
+         * @brief Appends samples following the onset
+         * @param input Next samples (those beyond maxBufferSize are ignored)
+         * @return Number of samples accepted
+         */
+        size_t Push(std::span<const float> input);
+
+        /**
+         * @brief Extends the difference sums to the pushed samples and re-estimates
+         * @param sampleRate Sample rate in Hz
+         * @return Pitch of the current window, nullopt if none passes the threshold yet
+         */
+        [[nodiscard]] std::optional<PitchResult> Refine(float sampleRate);
+
+        /**
+         * @brief Returns samples pushed since the onset
+         */
+        [[nodiscard]] size_t GetWindowSize() const;
+
+        /**
+         * @brief Returns true once the window has reached maxBufferSize
+         */
+        [[nodiscard]] bool IsComplete() const;
+
+    private:
+        /**
+         * @brief Adds the terms of the grown window to the difference sums
+         */
+        void Extend(size_t newHalfSize);
+
+        /**
+         * @brief Refines accepted lag by parabolic interpolation and builds result
+         */
+        [[nodiscard]] PitchResult MakeResult(size_t tau, float sampleRate) const;
+
+        ProgressivePitchDetectorConfig config; ///< Algorithm configuration
+        std::vector<float> window;             ///< Samples since the onset
+        std::vector<double> differences;       ///< Difference sum per lag over the integrated span
+        std::vector<float> yinBuffer;          ///< Cumulative mean normalized difference
+        size_t windowSize;                     ///< Samples in window
+        size_t halfSize;                       ///< Samples integrated by differences
+    };
+
+} // namespace GuitarDSP
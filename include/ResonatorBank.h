@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <complex>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Note tracked by a ResonatorBank
+     */
+    struct ResonatorTarget
+    {
+        std::string noteName; ///< Note name (e.g., "E", "F#", "Bb")
+        int32_t octave;       ///< Octave number
+    };
+
+    /**
+     * @brief Current state of one resonator
+     */
+    struct ResonatorReading
+    {
+        float frequency;       ///< Resonator frequency (Hz, target times harmonic)
+        float magnitude;       ///< Amplitude of a sinusoid at frequency (linear, full window)
+        float phase;           ///< Phase at the newest sample (radians, [-pi, pi])
+        float frequencyOffset; ///< Measured deviation from frequency (Hz, from phase advance)
+        float cents;           ///< frequencyOffset in cents
+    };
+
+    /**
+     * @brief Configuration for the target-frequency resonator bank
+     */
+    struct ResonatorBankConfig
+    {
+        float sampleRate = 48000.0f; ///< Sample rate (Hz)
+        float a4Frequency = 440.0f;  ///< Tuning reference (Hz)
+        size_t harmonicCount = 3;    ///< Resonators per target (fundamental and overtones)
+        size_t windowSize = 4096;    ///< Sliding DFT length (samples)
+        size_t offsetInterval = 256; ///< Samples between phase-advance measurements
+
+        /** @brief Notes to track (default: standard tuning) */
+        std::vector<ResonatorTarget> targets = {
+            { "E", 2 }, { "A", 2 }, { "D", 3 }, { "G", 3 }, { "B", 3 }, { "E", 4 }
+        };
+    };
+
+    /**
+     * @brief Sliding single-bin DFT at a fixed set of note frequencies
+     *
+     * Each target from config.targets (converted with NoteConverter) gets
+     * harmonicCount resonators at 1x, 2x, ... its frequency. A resonator is
+     * a sliding DFT of length windowSize evaluated at its exact frequency,
+     * which need not be an integer bin: with the demodulating phasor
+     * p[n] = exp(-j w n) its sum S[n] = sum of x[m] p[m] over the window is
+     * updated per sample as
+     *
+     *     S[n] = S[n-1] + p[n] (x[n] - x[n-N] exp(j w N))
+     *
+     * A rectangular window lets the negative-frequency image and the
+     * neighbouring partials leak in and bias the phase, so each resonator
+     * runs three such bins (w and w +- 2pi/N) and combines them into a
+     * Hann-windowed sum in the frequency domain. Every input sample
+     * therefore costs O(K) for K resonators, with one shared history of
+     * the last windowSize samples. Sums and phasors are kept in double;
+     * phasors are renormalized every offsetInterval samples and after
+     * every Process() call.
+     *
+     * Magnitude is the amplitude of a sinusoid at the resonator frequency.
+     * Every offsetInterval samples the phase advance of the windowed sum
+     * gives the deviation of the ringing partial from the target frequency
+     * (unambiguous up to sampleRate / (2 * offsetInterval)); it is only
+     * meaningful while the magnitude stands well above the noise.
+     *
+     * Real-time safe: Process() does not allocate.
+     */
+    class ResonatorBank
+    {
+    public:
+        /**
+         * @brief Constructs bank and pre-allocates resonators and history
+         * @param config Bank configuration
+         */
+        explicit ResonatorBank(const ResonatorBankConfig &config = ResonatorBankConfig{});
+
+        /**
+         * @brief Advances all resonators by the given samples
+         * @param input Next samples of the input stream (any length, including one)
+         */
+        void Process(std::span<const float> input);
+
+        /**
+         * @brief Returns readings of all resonators, target-major (target * harmonicCount + harmonic)
+         */
+        [[nodiscard]] std::span<const ResonatorReading> GetReadings() const;
+
+        /**
+         * @brief Returns reading of one resonator
+         * @param target Index into config.targets
+         * @param harmonic 0 for the fundamental
+         */
+        [[nodiscard]] const ResonatorReading &GetReading(size_t target, size_t harmonic) const;
+
+        /**
+         * @brief Returns number of targets
+         */
+        [[nodiscard]] size_t GetTargetCount() const;
+
+        /**
+         * @brief Returns index of the target with the largest summed harmonic magnitude
+         * @return Target index, or GetTargetCount() if all magnitudes are zero
+         */
+        [[nodiscard]] size_t GetStrongestTarget() const;
+
+        /**
+         * @brief Clears history, sums and readings
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Returns Hann-windowed sum of a partial from its three bins
+         */
+        [[nodiscard]] std::complex<double> GetWindowedSum(size_t partial) const;
+
+        /**
+         * @brief Updates magnitude and phase of every resonator
+         */
+        void UpdateReadings();
+
+        /**
+         * @brief Updates frequency offsets from the phase advance since the last measurement
+         */
+        void MeasureOffsets();
+
+        /**
+         * @brief Rescales phasors to unit length against rounding drift
+         */
+        void NormalizePhasors();
+
+        ResonatorBankConfig config;             ///< Bank configuration
+        std::vector<ResonatorReading> readings; ///< Reading per resonator
+        std::vector<double> stepRe;             ///< Phasor step exp(-j w) per bin, real part
+        std::vector<double> stepIm;             ///< Phasor step exp(-j w) per bin, imaginary part
+        std::vector<double> wrapRe;             ///< Oldest sample factor exp(j w N), real part
+        std::vector<double> wrapIm;             ///< Oldest sample factor exp(j w N), imaginary part
+        std::vector<double> phasorRe;           ///< Demodulating phasor p[n], real part
+        std::vector<double> phasorIm;           ///< Demodulating phasor p[n], imaginary part
+        std::vector<double> sumRe;              ///< Sliding sum S[n], real part
+        std::vector<double> sumIm;              ///< Sliding sum S[n], imaginary part
+        std::vector<double> lastAngle;          ///< Windowed sum angle per resonator at the last measurement
+        std::vector<float> history;             ///< Last windowSize input samples
+        size_t historyIndex;                    ///< Oldest sample in history
+        size_t sinceOffset;                     ///< Samples since the last offset measurement
+        bool hasLastAngle;                      ///< lastAngle is valid
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "FFTProcessor.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief One analysed hop handed to spectrum consumers
+     */
+    struct SpectrumFrame
+    {
+        const FFTSpectrum &spectrum;       ///< Windowed spectrum of the frame
+        std::span<const float> magnitudes; ///< Cached bin magnitudes [0, fftSize/2)
+        uint64_t hopIndex;                 ///< Zero-based frame counter
+        uint64_t frameStart;               ///< Stream index of first sample in the frame
+    };
+
+    /**
+     * @brief Receiver of shared spectra (onset detection, features, verification, ...)
+     */
+    class SpectrumConsumer
+    {
+    public:
+        virtual ~SpectrumConsumer() = default;
+
+        /**
+         * @brief Called once per hop with the shared spectrum
+         * @param frame Spectrum and magnitudes, valid only for the duration of the call
+         */
+        virtual void OnSpectrum(const SpectrumFrame &frame) = 0;
+    };
+
+    /**
+     * @brief Configuration for spectral analysis hub
+     */
+    struct SpectralAnalysisHubConfig
+    {
+        size_t fftSize = 2048;       ///< Frame and FFT size (power of 2)
+        size_t hopSize = 512;        ///< Samples between consecutive frames
+        float sampleRate = 48000.0f; ///< Sample rate (Hz)
+        bool applyWindow = true;     ///< Apply Hann window before the transform
+        size_t maxConsumers = 16;    ///< Consumer slots (pre-allocated)
+    };
+
+    /**
+     * @brief Shared STFT feeding every spectral consumer of a stream
+     *
+     * Owns one windowed STFT for a (frame size, hop) pair so features that
+     * need the same spectrum do not each transform the same hop. Frame k
+     * covers stream samples [k * hopSize, k * hopSize + fftSize).
+     *
+     * The transform is lazy: it runs once per hop, either when Push() reaches
+     * a hop boundary with consumers registered, or on the first GetSpectrum()
+     * / GetMagnitudes() call for that hop. Magnitudes are computed at most
+     * once per hop as well and shared by all consumers.
+     *
+     * Real-time safe: Push(), GetSpectrum() and GetMagnitudes() do not
+     * allocate. Register consumers before processing starts.
+     */
+    class SpectralAnalysisHub
+    {
+    public:
+        /**
+         * @brief Constructs hub and pre-allocates history, window and FFT
+         * @param config Hub configuration
+         */
+        explicit SpectralAnalysisHub(const SpectralAnalysisHubConfig &config = SpectralAnalysisHubConfig{});
+
+        /**
+         * @brief Registers consumer to be called on every hop
+         * @param consumer Consumer (not owned, must outlive registration)
+         * @return False if null, already registered or all slots are used
+         */
+        bool AddConsumer(SpectrumConsumer *consumer);
+
+        /**
+         * @brief Unregisters consumer
+         * @return False if consumer was not registered
+         */
+        bool RemoveConsumer(SpectrumConsumer *consumer);
+
+        /**
+         * @brief Appends samples and dispatches every completed hop
+         * @param samples Next block of the input stream (any length)
+         * @return Number of hops completed by this block
+         */
+        size_t Push(std::span<const float> samples);
+
+        /**
+         * @brief Returns true once the first full frame has been received
+         */
+        [[nodiscard]] bool HasFrame() const;
+
+        /**
+         * @brief Gets spectrum of the most recent frame, transforming it if needed
+         * @return Spectrum (all zero before the first frame)
+         */
+        const FFTSpectrum &GetSpectrum();
+
+        /**
+         * @brief Gets magnitudes of the most recent frame, computing them if needed
+         * @return Bin magnitudes [0, fftSize/2)
+         */
+        std::span<const float> GetMagnitudes();
+
+        /**
+         * @brief Returns hop index of the most recent frame
+         */
+        [[nodiscard]] uint64_t GetHopIndex() const;
+
+        /**
+         * @brief Returns number of transforms actually computed since construction or reset
+         */
+        [[nodiscard]] uint64_t GetTransformCount() const;
+
+        /**
+         * @brief Clears history and counters (consumers stay registered)
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Runs the transform for the current hop if not done yet
+         */
+        void EnsureSpectrum();
+
+        /**
+         * @brief Computes magnitudes for the current hop if not done yet
+         */
+        void EnsureMagnitudes();
+
+        /**
+         * @brief Hands the current hop to all consumers
+         */
+        void Dispatch();
+
+        SpectralAnalysisHubConfig config;          ///< Hub configuration
+        FFTProcessor fft;                          ///< Shared transform
+        std::vector<float> history;                ///< Mirrored ring, 2 * fftSize (frame always contiguous)
+        std::vector<float> window;                 ///< Analysis window coefficients
+        std::vector<float> frame;                  ///< Windowed frame scratch
+        std::vector<float> magnitudes;             ///< Cached magnitudes of current hop
+        std::vector<SpectrumConsumer *> consumers; ///< Registered consumers (capacity maxConsumers)
+        size_t writeIndex;                         ///< Next write position in history ring
+        uint64_t samplesReceived;                  ///< Total samples pushed
+        uint64_t hopIndex;                         ///< Index of the most recent frame
+        uint64_t transformCount;                   ///< Transforms computed
+        size_t samplesUntilFrame;                  ///< Samples still needed for the next frame
+        bool hasFrame;                             ///< At least one frame completed
+        bool spectrumValid;                        ///< Spectrum matches the current hop
+        bool magnitudesValid;                      ///< Magnitudes match the current hop
+    };
+
+} // namespace GuitarDSP
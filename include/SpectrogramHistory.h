@@ -0,0 +1,172 @@
+#pragma once
+
+#include "SpectrumBandReducer.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Storage width of one quantized spectrogram cell
+     */
+    enum class SpectrogramPrecision
+    {
+        Bits8, ///< 256 levels per frame (1 byte per cell)
+        Bits16 ///< 65536 levels per frame (2 bytes per cell)
+    };
+
+    /**
+     * @brief Configuration for spectrogram history
+     */
+    struct SpectrogramHistoryConfig
+    {
+        size_t binCount = 1024;                                       ///< Bins per appended frame (fftSize / 2)
+        size_t capacity = 3000;                                       ///< Frames kept (e.g. 30 s at 100 frames/s)
+        SpectrogramPrecision precision = SpectrogramPrecision::Bits8; ///< Cell width
+        float dynamicRangeDb = 96.0f;                                 ///< Range kept below each frame's maximum (dB)
+        float referenceMagnitude = 1.0f;                              ///< Bin magnitude stored as 0 dB
+        float sampleRate = 48000.0f;                                  ///< Sample rate (Hz, for row frequencies)
+        bool logFrequency = false;                                    ///< Store log-spaced bands instead of bins
+        size_t bandCount = 256;                                       ///< Rows in log-frequency mode (<= 512)
+        float minFrequency = 40.0f;                                   ///< Lowest band edge in log-frequency mode (Hz)
+        float maxFrequency = 16000.0f;                                ///< Highest band edge in log-frequency mode (Hz)
+    };
+
+    /**
+     * @brief Quantized ring of recent spectra for scrolling waterfall displays
+     *
+     * Each appended frame becomes one column of rows (FFT bins, or log-spaced
+     * bands reduced with SpectrumBandReducer). Levels are stored in dB,
+     * quantized to 8 or 16 bits against the frame's own range: the column
+     * keeps its minimum and step, and the range is limited to dynamicRangeDb
+     * below the frame maximum. Compared with float magnitudes this needs
+     * 4x (16-bit: 2x) less memory before any log-axis reduction.
+     *
+     * Columns are stored contiguously, so appending writes one block and
+     * column reads are sequential. Frames are addressed oldest first:
+     * frame 0 is the oldest retained, GetFrameCount() - 1 the newest.
+     *
+     * Real-time safe: Append() does not allocate. Not thread-safe; append
+     * and read from one thread or guard externally.
+     */
+    class SpectrogramHistory
+    {
+    public:
+        /**
+         * @brief Constructs history and pre-allocates all columns
+         * @param config History configuration
+         */
+        explicit SpectrogramHistory(const SpectrogramHistoryConfig &config = SpectrogramHistoryConfig{});
+
+        SpectrogramHistory(const SpectrogramHistory &) = delete;
+        SpectrogramHistory &operator=(const SpectrogramHistory &) = delete;
+        SpectrogramHistory(SpectrogramHistory &&) = delete;
+        SpectrogramHistory &operator=(SpectrogramHistory &&) = delete;
+
+        /**
+         * @brief Quantizes and appends one spectrum, dropping the oldest frame when full
+         * @param magnitudes Bin magnitudes [0, binCount) (e.g. SpectralAnalysisHub::GetMagnitudes)
+         * @return False if magnitudes holds fewer than binCount bins
+         */
+        bool Append(std::span<const float> magnitudes);
+
+        /**
+         * @brief Reads one frame
+         * @param frame Frame index (0 = oldest retained)
+         * @param levelsDb Output levels (dB), one per row; at most GetRowCount() are written
+         * @return False if frame is not retained
+         */
+        bool ReadColumn(size_t frame, std::span<float> levelsDb) const;
+
+        /**
+         * @brief Reads one row over consecutive frames
+         * @param row Row index (0 = lowest frequency)
+         * @param firstFrame Index of the first frame to read
+         * @param levelsDb Output levels (dB), one per frame
+         * @return Number of frames written
+         */
+        size_t ReadRow(size_t row, size_t firstFrame, std::span<float> levelsDb) const;
+
+        /**
+         * @brief Reads a rectangle of frames and rows
+         * @param firstFrame Index of the first frame
+         * @param frames Number of frames
+         * @param firstRow Index of the first row
+         * @param rows Number of rows
+         * @param levelsDb Output levels (dB), frame-major: levelsDb[f * rows + r]
+         * @return False if the region is not fully retained or output is too small
+         */
+        bool ReadRegion(size_t firstFrame,
+            size_t frames,
+            size_t firstRow,
+            size_t rows,
+            std::span<float> levelsDb) const;
+
+        /**
+         * @brief Returns number of rows per frame
+         */
+        [[nodiscard]] size_t GetRowCount() const;
+
+        /**
+         * @brief Returns centre frequency of a row (Hz)
+         * @param row Row index
+         */
+        [[nodiscard]] float GetRowFrequency(size_t row) const;
+
+        /**
+         * @brief Returns number of retained frames
+         */
+        [[nodiscard]] size_t GetFrameCount() const;
+
+        /**
+         * @brief Returns total frames appended since construction or reset
+         */
+        [[nodiscard]] uint64_t GetTotalFrames() const;
+
+        /**
+         * @brief Returns bytes used by quantized cells and column scales
+         */
+        [[nodiscard]] size_t GetMemoryUsage() const;
+
+        /**
+         * @brief Drops all frames
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Dequantization parameters of one column
+         */
+        struct ColumnScale
+        {
+            float minDb;  ///< Level of quantized value 0
+            float stepDb; ///< Level difference per quantized step
+        };
+
+        /**
+         * @brief Returns ring slot of a frame index
+         */
+        size_t GetSlot(size_t frame) const;
+
+        /**
+         * @brief Returns dequantized level of one cell
+         */
+        float ReadCell(size_t slot, size_t row) const;
+
+        SpectrogramHistoryConfig config;              ///< History configuration
+        size_t rowCount;                              ///< Rows per frame
+        std::unique_ptr<SpectrumBandReducer> reducer; ///< Band reduction (log-frequency mode only)
+        std::unique_ptr<DisplayBands> bands;          ///< Band reduction output (log-frequency mode only)
+        std::vector<float> levels;                    ///< dB scratch for the frame being appended
+        std::vector<uint8_t> cells8;                  ///< 8-bit cells, capacity * rowCount
+        std::vector<uint16_t> cells16;                ///< 16-bit cells, capacity * rowCount
+        std::vector<ColumnScale> scales;              ///< Per-column scale, capacity entries
+        size_t writeSlot;                             ///< Ring slot of the next appended frame
+        size_t frameCount;                            ///< Retained frames
+        uint64_t totalFrames;                         ///< Frames appended
+    };
+
+} // namespace GuitarDSP
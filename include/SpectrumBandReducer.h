@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Compact per-band display levels
+     *
+     * Fixed size and trivially copyable, so it can be published through a
+     * TripleBuffer<DisplayBands> instead of the full spectrum.
+     */
+    struct DisplayBands
+    {
+        static constexpr size_t MAX_BANDS = 512; ///< Capacity of the level arrays
+
+        std::array<float, MAX_BANDS> peakDb{}; ///< Loudest bin of each band (dB)
+        std::array<float, MAX_BANDS> meanDb{}; ///< Mean bin magnitude of each band (dB)
+        std::array<float, MAX_BANDS> holdDb{}; ///< Peak-hold marker of each band (dB)
+        uint32_t bandCount = 0;                ///< Valid entries in the level arrays
+        uint64_t sequence = 0;                 ///< Reduction counter (0 = nothing reduced yet)
+    };
+
+    /**
+     * @brief Configuration for display band reduction
+     */
+    struct SpectrumBandReducerConfig
+    {
+        size_t fftSize = 2048;                    ///< FFT size of the incoming magnitudes
+        float sampleRate = 48000.0f;              ///< Sample rate (Hz)
+        size_t bandCount = 128;                   ///< Display bands (at most DisplayBands::MAX_BANDS)
+        float minFrequency = 40.0f;               ///< Lower edge of the first band (Hz)
+        float maxFrequency = 16000.0f;            ///< Upper edge of the last band (Hz)
+        float referenceMagnitude = 1.0f;          ///< Bin magnitude shown as 0 dB
+        float floorDb = -120.0f;                  ///< Lowest level reported (dB)
+        float updateInterval = 512.0f / 48000.0f; ///< Time between Process() calls (seconds, hop / rate)
+        float peakHoldSeconds = 0.5f;             ///< Time a new peak is held before decaying
+        float peakDecayDbPerSecond = 24.0f;       ///< Peak-hold fall rate after the hold time
+    };
+
+    /**
+     * @brief Reduces FFT magnitudes to log-spaced display bands with peak hold
+     *
+     * Band edges are spaced logarithmically between minFrequency and
+     * maxFrequency and mapped to bin ranges once in the constructor. Each
+     * band covers at least one bin; low bands narrower than a bin share the
+     * nearest bin. Per band, Process() takes the maximum and mean magnitude
+     * with the dispatched SIMD kernels, converts them to dB and advances the
+     * peak-hold state.
+     *
+     * Meant to run on the analysis side so only a DisplayBands value (a few
+     * kilobytes) crosses to the UI thread.
+     *
+     * Real-time safe: Process() does not allocate.
+     */
+    class SpectrumBandReducer
+    {
+    public:
+        /**
+         * @brief Constructs reducer and precomputes band bin ranges
+         * @param config Reducer configuration
+         */
+        explicit SpectrumBandReducer(const SpectrumBandReducerConfig &config = SpectrumBandReducerConfig{});
+
+        /**
+         * @brief Reduces one frame of magnitudes to display bands
+         * @param magnitudes Bin magnitudes [0, fftSize/2) (e.g. SpectralAnalysisHub::GetMagnitudes)
+         * @param output Band levels (e.g. the write buffer of a TripleBuffer<DisplayBands>)
+         * @return False if magnitudes holds fewer than fftSize/2 bins (output unchanged)
+         */
+        bool Process(std::span<const float> magnitudes, DisplayBands &output);
+
+        /**
+         * @brief Returns number of display bands
+         */
+        [[nodiscard]] size_t GetBandCount() const;
+
+        /**
+         * @brief Returns geometric centre frequency of a band (Hz)
+         * @param band Band index
+         */
+        [[nodiscard]] float GetBandFrequency(size_t band) const;
+
+        /**
+         * @brief Returns first bin of a band
+         * @param band Band index
+         */
+        [[nodiscard]] size_t GetBandBegin(size_t band) const;
+
+        /**
+         * @brief Returns one past the last bin of a band
+         * @param band Band index
+         */
+        [[nodiscard]] size_t GetBandEnd(size_t band) const;
+
+        /**
+         * @brief Clears peak-hold state and the reduction counter
+         */
+        void Reset();
+
+    private:
+        /**
+         * @brief Converts a linear magnitude ratio to dB, clamped to floorDb
+         */
+        float ToDb(float ratio) const;
+
+        SpectrumBandReducerConfig config;                         ///< Reducer configuration
+        size_t bandCount;                                         ///< Bands in use
+        size_t binCount;                                          ///< Bins expected per frame
+        std::array<uint32_t, DisplayBands::MAX_BANDS> bandBegin;  ///< First bin of each band
+        std::array<uint32_t, DisplayBands::MAX_BANDS> bandEnd;    ///< One past the last bin of each band
+        std::array<float, DisplayBands::MAX_BANDS> bandFrequency; ///< Centre frequency of each band (Hz)
+        std::array<float, DisplayBands::MAX_BANDS> holdDb;        ///< Current peak-hold level
+        std::array<float, DisplayBands::MAX_BANDS> holdRemaining; ///< Hold time left before decay (seconds)
+        uint64_t sequence;                                        ///< Frames reduced
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "FFTProcessor.h"
+#include "TripleBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Spectrum and derived magnitudes published together
+     */
+    struct SpectrumSnapshot
+    {
+        /**
+         * @brief Constructs zeroed snapshot
+         * @param fftSize FFT size
+         * @param sampleRate Sample rate (Hz)
+         */
+        SpectrumSnapshot(size_t fftSize, float sampleRate);
+
+        FFTSpectrum spectrum;          ///< Complex spectrum
+        std::vector<float> magnitudes; ///< Bin magnitudes [0, fftSize/2)
+        uint64_t sequence;             ///< Publication counter (0 = nothing published yet)
+    };
+
+    /**
+     * @brief Lock-free hand-over of spectra from the audio thread to a display thread
+     *
+     * The audio thread transforms straight into the back buffer of a
+     * TripleBuffer and publishes it; the display thread reads the newest
+     * complete snapshot by reference. Neither side locks, and the reader
+     * never copies: a snapshot returned by Read() stays unchanged until the
+     * reader calls Read() again.
+     *
+     * One producer thread and one consumer thread.
+     * Real-time safe: Publish() does not allocate or block.
+     */
+    class SpectrumPublisher
+    {
+    public:
+        /**
+         * @brief Constructs publisher with three pre-allocated snapshots
+         * @param fftSize FFT size (must match the FFTProcessor used with Publish)
+         * @param sampleRate Sample rate (Hz)
+         */
+        SpectrumPublisher(size_t fftSize, float sampleRate);
+
+        /**
+         * @brief Producer: transforms audio into the back buffer and publishes it
+         * @param fft FFT processor of matching size
+         * @param audioData Input audio samples (must be >= fftSize)
+         */
+        void Publish(FFTProcessor &fft, std::span<const float> audioData);
+
+        /**
+         * @brief Producer: publishes a spectrum computed elsewhere (one copy into the back buffer)
+         * @param spectrum Spectrum of matching size (e.g. from SpectralAnalysisHub)
+         */
+        void Publish(const FFTSpectrum &spectrum);
+
+        /**
+         * @brief Consumer: returns the newest published snapshot
+         * @return Snapshot, valid until the next Read(); sequence is 0 before the first publication
+         */
+        const SpectrumSnapshot &Read();
+
+        /**
+         * @brief Consumer: returns true if Read() would return a newer snapshot
+         */
+        [[nodiscard]] bool HasNewSnapshot() const;
+
+    private:
+        /**
+         * @brief Computes magnitudes of the back buffer and publishes it
+         */
+        void Commit(SpectrumSnapshot &snapshot);
+
+        TripleBuffer<SpectrumSnapshot> buffers; ///< Snapshot rotation
+        uint64_t sequence;                      ///< Last published sequence number
+    };
+
+} // namespace GuitarDSP
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Instrumented detector stages
+     */
+    enum class ProfileStage : uint32_t
+    {
+        YinDifference,           ///< YIN difference function and normalisation
+        YinThreshold,            ///< YIN threshold search and interpolation
+        MpmNsdf,                 ///< MPM NSDF computation
+        MpmPeakPicking,          ///< MPM peak picking and interpolation
+        HybridYin,               ///< Hybrid detector YIN pass
+        HybridMpm,               ///< Hybrid detector MPM fallback pass
+        HybridHarmonicRejection, ///< Hybrid detector harmonic rejection
+        Count                    ///< Number of stages
+    };
+
+    /**
+     * @brief Distribution summary of per-call cycle counts
+     */
+    struct StageStatistics
+    {
+        size_t count;  ///< Number of samples
+        uint64_t min;  ///< Minimum (cycles)
+        double mean;   ///< Mean (cycles)
+        uint64_t p50;  ///< Median (cycles)
+        uint64_t p99;  ///< 99th percentile (cycles)
+        uint64_t p999; ///< 99.9th percentile (cycles)
+        uint64_t max;  ///< Maximum (cycles)
+    };
+
+    /**
+     * @brief Configuration for stage profiler
+     */
+    struct StageProfilerConfig
+    {
+        size_t maxSamplesPerStage = 100000; ///< Recorded calls per stage (pre-allocated)
+    };
+
+    /**
+     * @brief Per-stage cycle count recorder for worst-case execution time analysis
+     *
+     * Detectors record stage timings into the profiler made active on the
+     * calling thread. Instrumentation is compiled in only when the library
+     * is built with GUITAR_DSP_ENABLE_PROFILING (GUITAR_DSP_PROFILING defined);
+     * otherwise the stage scopes compile to nothing.
+     *
+     * Real-time safe: Record() writes into storage pre-allocated in the
+     * constructor and drops samples once a stage is full.
+     */
+    class StageProfiler
+    {
+    public:
+        /**
+         * @brief Constructs stage profiler
+         * @param config Profiler configuration
+         */
+        explicit StageProfiler(const StageProfilerConfig &config = StageProfilerConfig{});
+
+        /**
+         * @brief Records one stage execution
+         * @param stage Profiled stage
+         * @param cycles Elapsed cycle count
+         */
+        void Record(ProfileStage stage, uint64_t cycles);
+
+        /**
+         * @brief Returns recorded cycle counts of a stage
+         */
+        [[nodiscard]] std::span<const uint64_t> GetSamples(ProfileStage stage) const;
+
+        /**
+         * @brief Returns number of samples dropped because a stage was full
+         */
+        [[nodiscard]] size_t GetDroppedCount(ProfileStage stage) const;
+
+        /**
+         * @brief Computes distribution summary of a stage (allocates)
+         */
+        [[nodiscard]] StageStatistics ComputeStatistics(ProfileStage stage) const;
+
+        /**
+         * @brief Clears all recorded samples
+         */
+        void Reset();
+
+        /**
+         * @brief Computes distribution summary of arbitrary cycle counts (allocates)
+         */
+        [[nodiscard]] static StageStatistics ComputeStatistics(std::span<const uint64_t> samples);
+
+        /**
+         * @brief Returns display name of a stage
+         */
+        [[nodiscard]] static const char *GetStageName(ProfileStage stage);
+
+        /**
+         * @brief Makes profiler active on the calling thread (nullptr disables)
+         */
+        static void SetActive(StageProfiler *profiler);
+
+        /**
+         * @brief Returns profiler active on the calling thread
+         */
+        [[nodiscard]] static StageProfiler *GetActive();
+
+        /**
+         * @brief Reads the CPU cycle counter (monotonic nanoseconds as fallback)
+         */
+        [[nodiscard]] static uint64_t ReadCycleCounter()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            uint64_t value = 0;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                                             .count());
+#endif
+        }
+
+    private:
+        static constexpr size_t STAGE_COUNT = static_cast<size_t>(ProfileStage::Count);
+
+        StageProfilerConfig config;                             ///< Profiler configuration
+        std::array<std::vector<uint64_t>, STAGE_COUNT> samples; ///< Recorded cycle counts (pre-allocated)
+        std::array<size_t, STAGE_COUNT> sampleCounts;           ///< Valid samples per stage
+        std::array<size_t, STAGE_COUNT> droppedCounts;          ///< Samples dropped per stage
+    };
+
+    /**
+     * @brief Records elapsed cycles of the enclosing scope into the active profiler
+     */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(ProfileStage stage) : stage(stage), start(StageProfiler::ReadCycleCounter())
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (StageProfiler *profiler = StageProfiler::GetActive())
+            {
+                profiler->Record(stage, StageProfiler::ReadCycleCounter() - start);
+            }
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        ProfileStage stage; ///< Profiled stage
+        uint64_t start;     ///< Cycle counter at scope entry
+    };
+
+} // namespace GuitarDSP
+
+#if defined(GUITAR_DSP_PROFILING)
+#define GUITAR_DSP_PROFILE_CONCAT_INNER(a, b) a##b
+#define GUITAR_DSP_PROFILE_CONCAT(a, b) GUITAR_DSP_PROFILE_CONCAT_INNER(a, b)
+#define GUITAR_DSP_PROFILE_STAGE(stage) \
+    const ::GuitarDSP::ProfileScope GUITAR_DSP_PROFILE_CONCAT(guitarDspProfileScope, __LINE__)(stage)
+#else
+#define GUITAR_DSP_PROFILE_STAGE(stage) ((void)0)
+#endif
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace GuitarDSP
+{
+    /**
+     * @brief Lock-free single-producer single-consumer triple buffer
+     *
+     * The producer fills the back buffer and publishes it; the consumer
+     * picks up the most recently published buffer. Neither side waits for
+     * the other and no data is copied: publication and pickup exchange
+     * buffer indices through a single atomic. Intermediate publications the
+     * consumer did not pick up are dropped, so the consumer always sees the
+     * newest complete value.
+     *
+     * Real-time safe: Publish() and Update() are wait-free.
+     *
+     * @tparam T Buffer type (constructed three times up front)
+     */
+    template<typename T>
+    class TripleBuffer
+    {
+    public:
+        /**
+         * @brief Constructs three buffers as T(args...)
+         * @param args Constructor arguments shared by all buffers
+         */
+        template<typename... Args>
+        explicit TripleBuffer(const Args &...args)
+            : buffers{ { T(args...), T(args...), T(args...) } }, middle(1), writeIndex(0), readIndex(2)
+        {
+        }
+
+        TripleBuffer(const TripleBuffer &) = delete;
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+        TripleBuffer(TripleBuffer &&) = delete;
+        TripleBuffer &operator=(TripleBuffer &&) = delete;
+
+        /**
+         * @brief Producer: returns buffer to fill before the next Publish()
+         */
+        T &GetWriteBuffer()
+        {
+            return buffers[writeIndex];
+        }
+
+        /**
+         * @brief Producer: publishes the write buffer and takes a new one
+         */
+        void Publish()
+        {
+            const auto published = static_cast<uint8_t>(writeIndex | FRESH);
+            const uint8_t previous = middle.exchange(published, std::memory_order_acq_rel);
+            writeIndex = previous & INDEX_MASK;
+        }
+
+        /**
+         * @brief Consumer: picks up the newest published buffer, if any
+         * @return True if GetReadBuffer() now refers to a newer buffer
+         */
+        bool Update()
+        {
+            if ((middle.load(std::memory_order_acquire) & FRESH) == 0)
+            {
+                return false;
+            }
+
+            const uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        /**
+         * @brief Consumer: returns the buffer picked up by the last Update()
+         *
+         * Stays valid and unchanged until the consumer calls Update() again.
+         */
+        const T &GetReadBuffer() const
+        {
+            return buffers[readIndex];
+        }
+
+        /**
+         * @brief Returns true if a buffer was published since the consumer's last Update()
+         */
+        [[nodiscard]] bool HasUpdate() const
+        {
+            return (middle.load(std::memory_order_acquire) & FRESH) != 0;
+        }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3; ///< Buffer index bits of middle
+        static constexpr uint8_t FRESH = 0x4;      ///< Middle buffer not yet picked up
+
+        std::array<T, 3> buffers;    ///< Write, middle and read buffers (roles rotate)
+        std::atomic<uint8_t> middle; ///< Index of the middle buffer plus FRESH flag
+        uint8_t writeIndex;          ///< Producer's buffer
+        uint8_t readIndex;           ///< Consumer's buffer
+    };
+
+} // namespace GuitarDSP
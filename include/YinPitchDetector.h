@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AccumulationPolicy.h"
 #include "PitchDetector.h"
 #include <memory>
 #include <vector>
@@ -11,9 +12,14 @@ namespace GuitarDSP
      */
     struct YinPitchDetectorConfig
     {
-        float threshold = 0.15f;      ///< Detection threshold [0.0, 1.0]
-        float minFrequency = 80.0f;   ///< Minimum detectable frequency (Hz)
-        float maxFrequency = 1200.0f; ///< Maximum detectable frequency (Hz)
+        float threshold = 0.15f;                                        ///< Detection threshold [0.0, 1.0]
+        float minFrequency = 80.0f;                                     ///< Minimum detectable frequency (Hz)
+        float maxFrequency = 1200.0f;                                   ///< Maximum detectable frequency (Hz)
+        AccumulationPrecision precision = AccumulationPrecision::Float; ///< Difference and running sum precision
+        size_t maxBufferSize = 4096;                                    ///< Largest input buffer (pre-allocated)
+        bool lazyEvaluation = false;                                    ///< Stop at the first accepted dip
+        float adaptivePeriods = 0.0f;                                   ///< Refine on this many periods (0 = off)
+        float adaptiveLagTolerance = 0.06f;                             ///< Refined lag search around coarse lag
     };
 
     /**
@@ -23,6 +29,23 @@ namespace GuitarDSP
      * by Alain de Cheveigné and Hideki Kawahara (2002)
      *
      * Provides ±0.1 cent accuracy for guitar tuning applications.
+     *
+     * With config.lazyEvaluation the difference function and cumulative mean
+     * are computed together in lag order, and evaluation stops once the first
+     * dip below threshold has reached its minimum. High notes then cost only
+     * their first period of lags instead of half the buffer. The estimate is
+     * taken at the dip minimum rather than at the threshold crossing.
+     *
+     * With config.adaptivePeriods the window follows the pitch: a coarse
+     * lazy pass integrates one longest period on the newest samples, then
+     * the estimate is refined on only the newest adaptivePeriods periods of
+     * the coarse pitch, searching lags within adaptiveLagTolerance of the
+     * coarse lag. High notes are then analysed on a few milliseconds of
+     * audio and the work drops from O(N * tau) to about
+     * O(maxTau * tau + tau^2). The refined confidence is the normalized
+     * square difference 1 - d(tau) / (e0 + e_tau) at the refined lag; if
+     * the refined minimum lies on the edge of the search range the coarse
+     * estimate is returned.
      */
     class YinPitchDetector : public PitchDetector
     {
@@ -40,6 +63,39 @@ namespace GuitarDSP
         void Reset() override;
 
     private:
+        /**
+         * @brief Computes difference function and cumulative mean normalisation
+         * @tparam Policy Accumulation policy (see AccumulationPolicy.h)
+         */
+        template<typename Policy>
+        void ComputeNormalizedDifference(std::span<const float> buffer, size_t halfBufferSize);
+
+        /**
+         * @brief Computes normalized difference in lag order up to the first accepted dip minimum
+         * @tparam Policy Accumulation policy (see AccumulationPolicy.h)
+         * @return Lag of the dip minimum, nullopt if no lag below maxTau passes the threshold
+         */
+        template<typename Policy>
+        std::optional<size_t> FindFirstDipLazy(std::span<const float> buffer,
+            size_t halfBufferSize,
+            size_t minTau,
+            size_t maxTau);
+
+        /**
+         * @brief Coarse lazy estimate followed by a refinement on adaptivePeriods periods
+         * @tparam Policy Accumulation policy (see AccumulationPolicy.h)
+         */
+        template<typename Policy>
+        std::optional<PitchResult> DetectAdaptive(std::span<const float> buffer,
+            size_t minTau,
+            size_t maxTau,
+            float sampleRate);
+
+        /**
+         * @brief Refines accepted lag by parabolic interpolation and builds result
+         */
+        [[nodiscard]] PitchResult MakeResult(size_t tau, size_t halfBufferSize, float sampleRate) const;
+
         YinPitchDetectorConfig config; ///< Algorithm configuration
         std::vector<float> yinBuffer;  ///< Temporary buffer for YIN calculation
     };
@@ -0,0 +1,401 @@
+// Python bindings for guitar-dsp (module guitar_dsp).
+//
+// One-dimensional C-contiguous float32 NumPy arrays are read in place; other
+// dtypes or layouts are converted once on entry. Detector calls and
+// spectrogram release the GIL; a detector serializes its own calls with a
+// per-instance mutex, so one detector may be shared between Python threads.
+// The whole-signal methods (detect_frames, spectrogram) split frames across
+// worker threads, each with its own detector or FFT instance. Stabilizers
+// and FFTProcessor.compute_spectrum keep the GIL, which guards the shared
+// instance.
+//
+//     import numpy as np, guitar_dsp
+//     detector = guitar_dsp.HybridPitchDetector()
+//     frequencies, confidences = detector.detect_frames(signal, 4096, 512, 48000.0)
+
+#include "FFTProcessor.h"
+#include "HybridPitchDetector.h"
+#include "KernelDispatch.h"
+#include "MpmPitchDetector.h"
+#include "NoteConverter.h"
+#include "PitchStabilizer.h"
+#include "YinPitchDetector.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace py = pybind11;
+using namespace GuitarDSP;
+
+namespace
+{
+    /// float32 array argument: C-contiguous float32 input is used without copying
+    using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+    constexpr float NO_PITCH = std::numeric_limits<float>::quiet_NaN();
+
+    std::span<const float> AsSpan(const FloatArray &array)
+    {
+        if (array.ndim() != 1)
+        {
+            throw py::value_error("expected a one-dimensional array");
+        }
+
+        return { array.data(), static_cast<size_t>(array.shape(0)) };
+    }
+
+    size_t CountFrames(size_t signalLength, size_t frameSize, size_t hopSize)
+    {
+        if (frameSize == 0 || hopSize == 0)
+        {
+            throw py::value_error("frame_size and hop_size must be positive");
+        }
+
+        return signalLength >= frameSize ? (signalLength - frameSize) / hopSize + 1 : 0;
+    }
+
+    size_t ResolveWorkerCount(int threads, size_t jobs)
+    {
+        const size_t requested = threads > 0 ? static_cast<size_t>(threads)
+                                             : std::max<size_t>(1, std::thread::hardware_concurrency());
+        return std::clamp<size_t>(requested, 1, std::max<size_t>(jobs, 1));
+    }
+
+    /**
+     * @brief Runs body(worker, begin, end) over [0, jobs) in contiguous ranges, one per worker
+     */
+    template<typename Body>
+    void ParallelFor(size_t jobs, size_t workers, const Body &body)
+    {
+        const size_t chunk = (jobs + workers - 1) / std::max<size_t>(workers, 1);
+        std::vector<std::thread> threads;
+        threads.reserve(workers > 0 ? workers - 1 : 0);
+
+        for (size_t worker = 1; worker < workers; ++worker)
+        {
+            const size_t begin = std::min(jobs, worker * chunk);
+            const size_t end = std::min(jobs, begin + chunk);
+            threads.emplace_back([&body, worker, begin, end] { body(worker, begin, end); });
+        }
+
+        body(0, 0, std::min(jobs, chunk));
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Python-facing detector keeping its config for per-thread copies
+     */
+    template<typename Detector, typename Config>
+    class PyDetector
+    {
+    public:
+        explicit PyDetector(const Config &config) : config(config), detector(config)
+        {
+        }
+
+        std::optional<PitchResult> Detect(const FloatArray &frame, float sampleRate)
+        {
+            const auto samples = AsSpan(frame);
+            py::gil_scoped_release release;
+            const std::lock_guard<std::mutex> lock(mutex);
+            return detector.Detect(samples, sampleRate);
+        }
+
+        py::tuple DetectFrames(const FloatArray &signal,
+            size_t frameSize,
+            size_t hopSize,
+            float sampleRate,
+            int threads)
+        {
+            const auto samples = AsSpan(signal);
+            const size_t frameCount = CountFrames(samples.size(), frameSize, hopSize);
+
+            py::array_t<float> frequencies(static_cast<py::ssize_t>(frameCount));
+            py::array_t<float> confidences(static_cast<py::ssize_t>(frameCount));
+            float *frequencyData = frequencies.mutable_data();
+            float *confidenceData = confidences.mutable_data();
+
+            {
+                py::gil_scoped_release release;
+                const std::lock_guard<std::mutex> lock(mutex);
+
+                // Detectors are not thread-safe: worker 0 uses this one, the others private copies
+                const size_t workers = ResolveWorkerCount(threads, frameCount);
+                std::vector<std::unique_ptr<Detector>> workerDetectors;
+                for (size_t worker = 1; worker < workers; ++worker)
+                {
+                    workerDetectors.push_back(std::make_unique<Detector>(config));
+                }
+
+                ParallelFor(frameCount, workers, [&](size_t worker, size_t begin, size_t end) {
+                    Detector &active = worker == 0 ? detector : *workerDetectors[worker - 1];
+                    for (size_t frame = begin; frame < end; ++frame)
+                    {
+                        const auto result = active.Detect(samples.subspan(frame * hopSize, frameSize), sampleRate);
+                        frequencyData[frame] = result.has_value() ? result->frequency : NO_PITCH;
+                        confidenceData[frame] = result.has_value() ? result->confidence : 0.0f;
+                    }
+                });
+            }
+
+            return py::make_tuple(frequencies, confidences);
+        }
+
+        void Reset()
+        {
+            py::gil_scoped_release release;
+            const std::lock_guard<std::mutex> lock(mutex);
+            detector.Reset();
+        }
+
+        const Config &GetConfig() const
+        {
+            return config;
+        }
+
+    private:
+        Config config;     ///< Detector configuration (for worker copies)
+        Detector detector; ///< Detector used by single-frame calls
+        std::mutex mutex;  ///< Serializes calls on detector while the GIL is released
+    };
+
+    template<typename Detector, typename Config>
+    void BindDetector(py::module_ &module, const char *name)
+    {
+        using Wrapper = PyDetector<Detector, Config>;
+
+        py::class_<Wrapper>(module, name)
+            .def(py::init<const Config &>(), py::arg("config") = Config{})
+            .def("detect", &Wrapper::Detect, py::arg("frame"), py::arg("sample_rate"),
+                 "Detects pitch in one frame, returns PitchResult or None")
+            .def("detect_frames", &Wrapper::DetectFrames, py::arg("signal"), py::arg("frame_size"),
+                 py::arg("hop_size"), py::arg("sample_rate"), py::arg("threads") = 0,
+                 "Detects pitch in every frame of a signal in parallel.\n"
+                 "Returns (frequencies, confidences) float32 arrays; frames without pitch are NaN.")
+            .def("reset", &Wrapper::Reset)
+            .def_property_readonly("config", &Wrapper::GetConfig);
+    }
+
+    /**
+     * @brief Feeds a frequency/confidence sequence through a stabilizer
+     *
+     * NaN frequencies (no pitch) are skipped; the output holds the stabilized
+     * frequency after every input. Runs under the GIL, which guards the
+     * shared stabilizer.
+     */
+    py::array_t<float> StabilizeSequence(PitchStabilizer &stabilizer,
+        const FloatArray &frequencies,
+        const FloatArray &confidences)
+    {
+        const auto frequencyData = AsSpan(frequencies);
+        const auto confidenceData = AsSpan(confidences);
+        if (frequencyData.size() != confidenceData.size())
+        {
+            throw py::value_error("frequencies and confidences must have the same length");
+        }
+
+        py::array_t<float> stabilized(static_cast<py::ssize_t>(frequencyData.size()));
+        float *output = stabilized.mutable_data();
+
+        for (size_t i = 0; i < frequencyData.size(); ++i)
+        {
+            if (!std::isnan(frequencyData[i]))
+            {
+                stabilizer.Update(PitchResult{ frequencyData[i], confidenceData[i] });
+            }
+            output[i] = stabilizer.GetStabilized().frequency;
+        }
+
+        return stabilized;
+    }
+
+    py::array_t<float> SpectrumMagnitudes(const FFTProcessor &processor)
+    {
+        const FFTSpectrum &spectrum = processor.GetSpectrum();
+        const size_t binCount = spectrum.fftSize / 2;
+
+        py::array_t<float> magnitudes(static_cast<py::ssize_t>(binCount));
+        GetKernels().complexMagnitude(spectrum.data.data(), magnitudes.mutable_data(), binCount);
+        return magnitudes;
+    }
+
+    /**
+     * @brief Magnitude spectrogram of a signal, shape (frames, fft_size / 2)
+     *
+     * Every worker uses a private FFTProcessor, so the shared one is only
+     * read (for its size and sample rate) while the GIL is released.
+     */
+    py::array_t<float> Spectrogram(const FFTProcessor &processor, const FloatArray &signal, size_t hopSize, int threads)
+    {
+        const auto samples = AsSpan(signal);
+        const size_t fftSize = processor.GetSpectrum().fftSize;
+        const float sampleRate = processor.GetSpectrum().sampleRate;
+        const size_t binCount = fftSize / 2;
+        const size_t frameCount = CountFrames(samples.size(), fftSize, hopSize);
+
+        py::array_t<float> magnitudes(
+            std::vector<py::ssize_t>{ static_cast<py::ssize_t>(frameCount), static_cast<py::ssize_t>(binCount) });
+        float *output = magnitudes.mutable_data();
+
+        {
+            py::gil_scoped_release release;
+
+            const size_t workers = ResolveWorkerCount(threads, frameCount);
+            std::vector<std::unique_ptr<FFTProcessor>> workerProcessors;
+            for (size_t worker = 0; worker < workers; ++worker)
+            {
+                workerProcessors.push_back(std::make_unique<FFTProcessor>(fftSize, sampleRate));
+            }
+
+            const KernelTable &kernels = GetKernels();
+            ParallelFor(frameCount, workers, [&](size_t worker, size_t begin, size_t end) {
+                FFTProcessor &active = *workerProcessors[worker];
+                for (size_t frame = begin; frame < end; ++frame)
+                {
+                    active.ComputeSpectrum(samples.subspan(frame * hopSize, fftSize));
+                    kernels.complexMagnitude(active.GetSpectrum().data.data(), output + frame * binCount, binCount);
+                }
+            });
+        }
+
+        return magnitudes;
+    }
+
+    template<typename Stabilizer, typename Config>
+    void BindStabilizer(py::module_ &module, const char *name)
+    {
+        py::class_<Stabilizer, PitchStabilizer>(module, name).def(py::init<const Config &>(),
+                                                                   py::arg("config") = Config{});
+    }
+} // namespace
+
+PYBIND11_MODULE(guitar_dsp, module)
+{
+    module.doc() = "Real-time guitar pitch detection and analysis";
+
+    py::class_<PitchResult>(module, "PitchResult")
+        .def(py::init<>())
+        .def(py::init<float, float>(), py::arg("frequency"), py::arg("confidence"))
+        .def_readwrite("frequency", &PitchResult::frequency)
+        .def_readwrite("confidence", &PitchResult::confidence)
+        .def("__repr__", [](const PitchResult &result) {
+            return "PitchResult(frequency=" + std::to_string(result.frequency)
+                   + ", confidence=" + std::to_string(result.confidence) + ")";
+        });
+
+    py::enum_<AccumulationPrecision>(module, "AccumulationPrecision")
+        .value("FLOAT", AccumulationPrecision::Float)
+        .value("DOUBLE", AccumulationPrecision::Double)
+        .value("COMPENSATED", AccumulationPrecision::Compensated);
+
+    py::class_<YinPitchDetectorConfig>(module, "YinPitchDetectorConfig")
+        .def(py::init<>())
+        .def_readwrite("threshold", &YinPitchDetectorConfig::threshold)
+        .def_readwrite("min_frequency", &YinPitchDetectorConfig::minFrequency)
+        .def_readwrite("max_frequency", &YinPitchDetectorConfig::maxFrequency)
+        .def_readwrite("precision", &YinPitchDetectorConfig::precision)
+        .def_readwrite("max_buffer_size", &YinPitchDetectorConfig::maxBufferSize)
+        .def_readwrite("lazy_evaluation", &YinPitchDetectorConfig::lazyEvaluation);
+
+    py::class_<MpmPitchDetectorConfig>(module, "MpmPitchDetectorConfig")
+        .def(py::init<>())
+        .def_readwrite("threshold", &MpmPitchDetectorConfig::threshold)
+        .def_readwrite("min_frequency", &MpmPitchDetectorConfig::minFrequency)
+        .def_readwrite("max_frequency", &MpmPitchDetectorConfig::maxFrequency)
+        .def_readwrite("cutoff", &MpmPitchDetectorConfig::cutoff)
+        .def_readwrite("small_cutoff", &MpmPitchDetectorConfig::smallCutoff)
+        .def_readwrite("precision", &MpmPitchDetectorConfig::precision)
+        .def_readwrite("max_buffer_size", &MpmPitchDetectorConfig::maxBufferSize)
+        .def_readwrite("lazy_evaluation", &MpmPitchDetectorConfig::lazyEvaluation);
+
+    py::class_<HybridPitchDetectorConfig>(module, "HybridPitchDetectorConfig")
+        .def(py::init<>())
+        .def_readwrite("yin_config", &HybridPitchDetectorConfig::yinConfig)
+        .def_readwrite("mpm_config", &HybridPitchDetectorConfig::mpmConfig)
+        .def_readwrite("yin_confidence_threshold", &HybridPitchDetectorConfig::yinConfidenceThreshold)
+        .def_readwrite("enable_harmonic_rejection", &HybridPitchDetectorConfig::enableHarmonicRejection)
+        .def_readwrite("harmonic_tolerance", &HybridPitchDetectorConfig::harmonicTolerance);
+
+    BindDetector<YinPitchDetector, YinPitchDetectorConfig>(module, "YinPitchDetector");
+    BindDetector<MpmPitchDetector, MpmPitchDetectorConfig>(module, "MpmPitchDetector");
+    BindDetector<HybridPitchDetector, HybridPitchDetectorConfig>(module, "HybridPitchDetector");
+
+    py::class_<EMAConfig>(module, "EMAConfig").def(py::init<>()).def_readwrite("alpha", &EMAConfig::alpha);
+
+    py::class_<MedianFilterConfig>(module, "MedianFilterConfig")
+        .def(py::init<>())
+        .def_readwrite("window_size", &MedianFilterConfig::windowSize);
+
+    py::class_<HybridStabilizerConfig>(module, "HybridStabilizerConfig")
+        .def(py::init<>())
+        .def_readwrite("base_alpha", &HybridStabilizerConfig::baseAlpha)
+        .def_readwrite("window_size", &HybridStabilizerConfig::windowSize);
+
+    py::class_<PitchStabilizer>(module, "PitchStabilizer")
+        .def("update", &PitchStabilizer::Update, py::arg("result"))
+        .def("get_stabilized", &PitchStabilizer::GetStabilized)
+        .def("reset", &PitchStabilizer::Reset)
+        .def_property_readonly("group_delay", &PitchStabilizer::GetGroupDelay)
+        .def("process", &StabilizeSequence, py::arg("frequencies"), py::arg("confidences"),
+             "Stabilizes a frequency sequence (NaN = no pitch), returns float32 array");
+
+    BindStabilizer<ExponentialMovingAverage, EMAConfig>(module, "ExponentialMovingAverage");
+    BindStabilizer<MedianFilter, MedianFilterConfig>(module, "MedianFilter");
+    BindStabilizer<HybridStabilizer, HybridStabilizerConfig>(module, "HybridStabilizer");
+
+    py::class_<FFTProcessor>(module, "FFTProcessor")
+        .def(py::init<size_t, float>(), py::arg("fft_size"), py::arg("sample_rate"))
+        .def(
+            "compute_spectrum",
+            [](FFTProcessor &processor, const FloatArray &frame) {
+                // Keeps the GIL: it guards the shared processor
+                const auto samples = AsSpan(frame);
+                processor.ComputeSpectrum(samples);
+            },
+            py::arg("frame"))
+        .def("magnitudes", &SpectrumMagnitudes, "Magnitudes of the most recent spectrum")
+        .def("spectrogram", &Spectrogram, py::arg("signal"), py::arg("hop_size"), py::arg("threads") = 0,
+             "Magnitude spectrogram, float32 array of shape (frames, fft_size / 2)")
+        .def("magnitude_at_frequency",
+             [](const FFTProcessor &processor, float frequency) {
+                 return processor.GetSpectrum().GetMagnitudeAtFrequency(frequency);
+             })
+        .def("band_energy",
+             [](const FFTProcessor &processor, float minFrequency, float maxFrequency) {
+                 return processor.GetSpectrum().ExtractBandEnergy(minFrequency, maxFrequency);
+             })
+        .def("spectral_centroid",
+             [](const FFTProcessor &processor) { return processor.GetSpectrum().CalculateSpectralCentroid(); });
+
+    py::class_<NoteInfo>(module, "NoteInfo")
+        .def_readonly("name", &NoteInfo::name)
+        .def_readonly("octave", &NoteInfo::octave)
+        .def_readonly("cents", &NoteInfo::cents)
+        .def_readonly("frequency", &NoteInfo::frequency);
+
+    py::class_<NoteConverter>(module, "NoteConverter")
+        .def_static("frequency_to_note", &NoteConverter::FrequencyToNote, py::arg("frequency"),
+                    py::arg("a4_frequency") = 440.0f)
+        .def_static("note_to_frequency", &NoteConverter::NoteToFrequency, py::arg("note_name"), py::arg("octave"),
+                    py::arg("a4_frequency") = 440.0f)
+        .def_static("frequency_to_cents", &NoteConverter::FrequencyToCents, py::arg("frequency1"),
+                    py::arg("frequency2"))
+        .def_static("midi_note_to_name", &NoteConverter::MidiNoteToName, py::arg("midi_note"))
+        .def_static("note_name_to_midi", &NoteConverter::NoteNameToMidi, py::arg("note_name"), py::arg("octave"));
+}
@@ -0,0 +1,111 @@
+#include "AsyncDetection.h"
+#include <algorithm>
+
+namespace GuitarDSP
+{
+    ThreadPoolExecutor::ThreadPoolExecutor(const ThreadPoolExecutorConfig &config) : stopping(false)
+    {
+        size_t threadCount = config.threadCount;
+        if (threadCount == 0)
+        {
+            threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ThreadPoolExecutor::~ThreadPoolExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPoolExecutor::Schedule(std::coroutine_handle<> handle)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(handle);
+        }
+        condition.notify_one();
+    }
+
+    size_t ThreadPoolExecutor::GetThreadCount() const
+    {
+        return workers.size();
+    }
+
+    void ThreadPoolExecutor::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty())
+                {
+                    return;
+                }
+
+                handle = queue.front();
+                queue.pop_front();
+            }
+
+            handle.resume();
+        }
+    }
+
+    Task<std::optional<PitchResult>> DetectAsync(PitchDetector &detector,
+        std::span<const float> buffer,
+        float sampleRate,
+        Executor &executor)
+    {
+        co_await ScheduleOn(executor);
+        co_return detector.Detect(buffer, sampleRate);
+    }
+
+    Task<size_t> ProcessBlockAsync(PitchDetector &detector,
+        std::span<const float> signal,
+        std::span<PitchResult> results,
+        AsyncBlockConfig config,
+        Executor &executor)
+    {
+        co_await ScheduleOn(executor);
+
+        if (config.frameSize == 0 || config.hopSize == 0 || signal.size() < config.frameSize)
+        {
+            co_return 0;
+        }
+
+        const size_t frameCount = std::min((signal.size() - config.frameSize) / config.hopSize + 1, results.size());
+        const size_t framesPerChunk = std::max<size_t>(config.framesPerChunk, 1);
+
+        for (size_t frame = 0; frame < frameCount; ++frame)
+        {
+            if (frame > 0 && frame % framesPerChunk == 0)
+            {
+                // Yield: other clips queued on the executor run before the next chunk
+                co_await ScheduleOn(executor);
+            }
+
+            const auto window = signal.subspan(frame * config.hopSize, config.frameSize);
+            const auto result = detector.Detect(window, config.sampleRate);
+            results[frame] = result.value_or(PitchResult{ 0.0f, 0.0f });
+        }
+
+        co_return frameCount;
+    }
+
+} // namespace GuitarDSP
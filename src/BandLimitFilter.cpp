@@ -0,0 +1,190 @@
+#include "BandLimitFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        constexpr uint32_t MAX_FILTER_ORDER = 8;    ///< Highest Butterworth order per filter
+        constexpr double MAX_CUTOFF_RATIO = 0.45;   ///< Low-pass is skipped above this fraction of the sample rate
+        constexpr double STATE_FLUSH_LEVEL = 1e-30; ///< State below this is flushed to zero after each block
+
+        /**
+         * @brief Group delay of polynomial c0 + c1 z^-1 + c2 z^-2 at normalized frequency
+         */
+        double PolynomialGroupDelay(double c0, double c1, double c2, double omega)
+        {
+            const std::complex<double> z1 = std::polar(1.0, -omega);
+            const std::complex<double> z2 = z1 * z1;
+            const std::complex<double> value = c0 + c1 * z1 + c2 * z2;
+            if (std::abs(value) < 1e-12)
+            {
+                return 0.0;
+            }
+
+            const std::complex<double> weighted = c1 * z1 + 2.0 * c2 * z2;
+            return (weighted / value).real();
+        }
+    } // namespace
+
+    BandLimitFilter::BandLimitFilter(const BandLimitFilterConfig &config)
+        : config(config), sections({}), state({}), sectionCount(0)
+    {
+        const double sampleRate = config.sampleRate;
+        if (sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        if (config.dcBlocker && config.dcBlockerFrequency > 0.0f)
+        {
+            // y[n] = g * (x[n] - x[n-1]) + R * y[n-1], g normalizes Nyquist gain to 1
+            const double pole = std::exp(-2.0 * std::numbers::pi * config.dcBlockerFrequency / sampleRate);
+            const double gain = 0.5 * (1.0 + pole);
+            sections[sectionCount++] = Section{ gain, -gain, 0.0, -pole, 0.0 };
+        }
+
+        const double highPassCutoff = static_cast<double>(config.minFrequency) * config.highPassRatio;
+        if (highPassCutoff > 0.0 && highPassCutoff < MAX_CUTOFF_RATIO * sampleRate)
+        {
+            AddButterworth(config.highPassOrder, highPassCutoff, true);
+        }
+
+        const double lowPassCutoff = static_cast<double>(config.maxFrequency) * config.lowPassRatio;
+        if (lowPassCutoff > 0.0 && lowPassCutoff < MAX_CUTOFF_RATIO * sampleRate)
+        {
+            AddButterworth(config.lowPassOrder, lowPassCutoff, false);
+        }
+    }
+
+    void BandLimitFilter::AddButterworth(uint32_t order, double cutoff, bool highPass)
+    {
+        // Odd orders are rounded up so every stage is a full biquad
+        const uint32_t pairs = (std::min(order, MAX_FILTER_ORDER) + 1) / 2;
+        const uint32_t evenOrder = pairs * 2;
+
+        const double omega = 2.0 * std::numbers::pi * cutoff / config.sampleRate;
+        const double cosOmega = std::cos(omega);
+        const double sinOmega = std::sin(omega);
+
+        for (uint32_t k = 0; k < pairs && sectionCount < MAX_SECTIONS; ++k)
+        {
+            // Butterworth pole pair k: Q = 1 / (2 cos(theta_k)), theta_k = (2k + 1) * pi / (2N)
+            const double theta = static_cast<double>(2 * k + 1) * std::numbers::pi / (2.0 * evenOrder);
+            const double q = 1.0 / (2.0 * std::cos(theta));
+            const double alpha = sinOmega / (2.0 * q);
+            const double a0 = 1.0 + alpha;
+
+            // RBJ cookbook high-pass / low-pass
+            const double edge = highPass ? (1.0 + cosOmega) * 0.5 : (1.0 - cosOmega) * 0.5;
+            const double middle = highPass ? -(1.0 + cosOmega) : (1.0 - cosOmega);
+
+            sections[sectionCount++] = Section{ edge / a0, middle / a0, edge / a0, -2.0 * cosOmega / a0,
+                                                (1.0 - alpha) / a0 };
+        }
+    }
+
+    void BandLimitFilter::Process(std::span<float> samples)
+    {
+        Process(samples, samples);
+    }
+
+    void BandLimitFilter::Process(std::span<const float> input, std::span<float> output)
+    {
+        const size_t count = std::min(input.size(), output.size());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Whole cascade per sample; in-place use is safe as each input is read before its output is written
+            double value = input[i];
+            for (size_t s = 0; s < sectionCount; ++s)
+            {
+                const Section &section = sections[s];
+                auto &z = state[s];
+
+                const double filtered = section.b0 * value + z[0];
+                z[0] = section.b1 * value - section.a1 * filtered + z[1];
+                z[1] = section.b2 * value - section.a2 * filtered;
+                value = filtered;
+            }
+            output[i] = static_cast<float>(value);
+        }
+
+        // Decaying state never reaches the denormal range during silence
+        for (size_t s = 0; s < sectionCount; ++s)
+        {
+            for (double &z : state[s])
+            {
+                if (std::abs(z) < STATE_FLUSH_LEVEL)
+                {
+                    z = 0.0;
+                }
+            }
+        }
+    }
+
+    void BandLimitFilter::Reset()
+    {
+        for (auto &z : state)
+        {
+            z.fill(0.0);
+        }
+    }
+
+    float BandLimitFilter::GetGroupDelay(float frequency) const
+    {
+        if (config.sampleRate <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        const double omega = 2.0 * std::numbers::pi * frequency / config.sampleRate;
+        double delay = 0.0;
+        for (size_t s = 0; s < sectionCount; ++s)
+        {
+            const Section &section = sections[s];
+            delay += PolynomialGroupDelay(section.b0, section.b1, section.b2, omega)
+                     - PolynomialGroupDelay(1.0, section.a1, section.a2, omega);
+        }
+
+        return static_cast<float>(delay);
+    }
+
+    float BandLimitFilter::GetGroupDelay() const
+    {
+        const float centre = std::sqrt(std::max(config.minFrequency, 1.0f) * std::max(config.maxFrequency, 1.0f));
+        return GetGroupDelay(centre);
+    }
+
+    float BandLimitFilter::GetMagnitudeResponse(float frequency) const
+    {
+        if (config.sampleRate <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        const double omega = 2.0 * std::numbers::pi * frequency / config.sampleRate;
+        const std::complex<double> z1 = std::polar(1.0, -omega);
+        const std::complex<double> z2 = z1 * z1;
+
+        double gain = 1.0;
+        for (size_t s = 0; s < sectionCount; ++s)
+        {
+            const Section &section = sections[s];
+            const std::complex<double> numerator = section.b0 + section.b1 * z1 + section.b2 * z2;
+            const std::complex<double> denominator = 1.0 + section.a1 * z1 + section.a2 * z2;
+            gain *= std::abs(numerator) / std::abs(denominator);
+        }
+
+        return static_cast<float>(gain);
+    }
+
+    size_t BandLimitFilter::GetSectionCount() const
+    {
+        return sectionCount;
+    }
+
+} // namespace GuitarDSP
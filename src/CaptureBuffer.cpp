@@ -0,0 +1,298 @@
+#include "CaptureBuffer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        // File magic and format version
+        constexpr std::array<char, 4> CAPTURE_MAGIC = { 'G', 'C', 'A', 'P' };
+        constexpr uint16_t CAPTURE_VERSION = 1;
+
+        // Fixed record sizes (bytes)
+        constexpr size_t HEADER_SIZE = 32;
+        constexpr size_t RECORD_SIZE = 32;
+
+        // Samples converted per stream write
+        constexpr size_t SAMPLE_BLOCK = 1024;
+
+        // Record flags
+        constexpr uint32_t FLAG_VALID = 1;
+
+        void PutU32(uint8_t *dst, uint32_t value)
+        {
+            for (size_t i = 0; i < 4; ++i)
+            {
+                dst[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        void PutU64(uint8_t *dst, uint64_t value)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                dst[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        void PutF32(uint8_t *dst, float value)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            PutU32(dst, bits);
+        }
+
+        uint32_t GetU32(const uint8_t *src)
+        {
+            uint32_t value = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                value |= static_cast<uint32_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        uint64_t GetU64(const uint8_t *src)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                value |= static_cast<uint64_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        float GetF32(const uint8_t *src)
+        {
+            const uint32_t bits = GetU32(src);
+            float value = 0.0f;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    } // namespace
+
+    std::span<const float> CaptureSnapshot::GetFrameSamples(const CaptureFrameRecord &frame) const
+    {
+        if (frame.frameStart < firstSample || frame.frameStart - firstSample + frame.frameSize > samples.size())
+        {
+            return {};
+        }
+
+        return std::span<const float>(samples).subspan(static_cast<size_t>(frame.frameStart - firstSample),
+            frame.frameSize);
+    }
+
+    CaptureBuffer::CaptureBuffer(const CaptureBufferConfig &config)
+        : config(config), samples({}), frames({}), samplesWritten(0), framesWritten(0),
+          freezeState(FreezeState::Running)
+    {
+        // Pre-allocate rings (real-time safe capture)
+        const float capacity = std::ceil(config.sampleRate * config.durationSeconds);
+        samples.resize(static_cast<size_t>(std::max(capacity, 1.0f)), 0.0f);
+        frames.resize(std::max<size_t>(config.maxFrames, 1), CaptureFrameRecord{ 0, 0, 0, { 0.0f, 0.0f }, false });
+    }
+
+    void CaptureBuffer::Push(std::span<const float> input)
+    {
+        if (CheckFrozen())
+        {
+            return;
+        }
+
+        // Only the newest capacity samples of an oversized block can be retained
+        const size_t capacity = samples.size();
+        const size_t skipped = input.size() > capacity ? input.size() - capacity : 0;
+        samplesWritten += skipped;
+        input = input.subspan(skipped);
+
+        size_t offset = 0;
+        while (offset < input.size())
+        {
+            const size_t position = static_cast<size_t>(samplesWritten % capacity);
+            const size_t chunk = std::min(input.size() - offset, capacity - position);
+            std::copy_n(input.begin() + static_cast<std::ptrdiff_t>(offset), chunk,
+                samples.begin() + static_cast<std::ptrdiff_t>(position));
+            samplesWritten += chunk;
+            offset += chunk;
+        }
+    }
+
+    void CaptureBuffer::RecordFrame(uint64_t frameStart,
+        size_t frameSize,
+        uint64_t cycles,
+        const std::optional<PitchResult> &result)
+    {
+        if (CheckFrozen())
+        {
+            return;
+        }
+
+        frames[static_cast<size_t>(framesWritten % frames.size())] = CaptureFrameRecord{ frameStart,
+            static_cast<uint32_t>(frameSize), cycles, result.value_or(PitchResult{ 0.0f, 0.0f }), result.has_value() };
+        ++framesWritten;
+
+        // Keep the slow frame and its input: stop writing from the next call on
+        if (config.freezeAboveCycles > 0 && cycles > config.freezeAboveCycles)
+        {
+            Freeze();
+        }
+    }
+
+    uint64_t CaptureBuffer::GetStreamPosition() const
+    {
+        return samplesWritten;
+    }
+
+    void CaptureBuffer::Freeze()
+    {
+        // A writer that already stopped stays Frozen
+        auto expected = FreezeState::Running;
+        freezeState.compare_exchange_strong(expected, FreezeState::Requested, std::memory_order_acq_rel);
+    }
+
+    bool CaptureBuffer::IsFrozen() const
+    {
+        return freezeState.load(std::memory_order_acquire) == FreezeState::Frozen;
+    }
+
+    void CaptureBuffer::Resume()
+    {
+        freezeState.store(FreezeState::Running, std::memory_order_release);
+    }
+
+    bool CaptureBuffer::CheckFrozen()
+    {
+        auto state = freezeState.load(std::memory_order_acquire);
+        if (state == FreezeState::Running)
+        {
+            return false;
+        }
+
+        // Fails only if Resume() ran in between; this one write is still dropped
+        if (state == FreezeState::Requested)
+        {
+            freezeState.compare_exchange_strong(state, FreezeState::Frozen, std::memory_order_acq_rel);
+        }
+        return true;
+    }
+
+    bool CaptureBuffer::Dump(std::ostream &stream) const
+    {
+        const size_t capacity = samples.size();
+        const auto retainedSamples = static_cast<size_t>(std::min<uint64_t>(samplesWritten, capacity));
+        const uint64_t firstSample = samplesWritten - retainedSamples;
+        const auto retainedFrames = static_cast<size_t>(std::min<uint64_t>(framesWritten, frames.size()));
+
+        std::array<uint8_t, HEADER_SIZE> header{};
+        std::memcpy(header.data(), CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size());
+        header[4] = static_cast<uint8_t>(CAPTURE_VERSION);
+        header[5] = static_cast<uint8_t>(CAPTURE_VERSION >> 8);
+        PutF32(header.data() + 8, config.sampleRate);
+        PutU32(header.data() + 12, static_cast<uint32_t>(retainedFrames));
+        PutU64(header.data() + 16, firstSample);
+        PutU64(header.data() + 24, retainedSamples);
+        stream.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+
+        // Samples oldest first, converted in blocks
+        std::array<uint8_t, SAMPLE_BLOCK * 4> block{};
+        for (size_t written = 0; written < retainedSamples;)
+        {
+            const size_t count = std::min(SAMPLE_BLOCK, retainedSamples - written);
+            for (size_t i = 0; i < count; ++i)
+            {
+                PutF32(block.data() + 4 * i, samples[static_cast<size_t>((firstSample + written + i) % capacity)]);
+            }
+            stream.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(count * 4));
+            written += count;
+        }
+
+        std::array<uint8_t, RECORD_SIZE> record{};
+        const uint64_t firstFrame = framesWritten - retainedFrames;
+        for (size_t i = 0; i < retainedFrames; ++i)
+        {
+            const CaptureFrameRecord &frame = frames[static_cast<size_t>((firstFrame + i) % frames.size())];
+            PutU64(record.data(), frame.frameStart);
+            PutU64(record.data() + 8, frame.cycles);
+            PutU32(record.data() + 16, frame.frameSize);
+            PutU32(record.data() + 20, frame.valid ? FLAG_VALID : 0);
+            PutF32(record.data() + 24, frame.result.frequency);
+            PutF32(record.data() + 28, frame.result.confidence);
+            stream.write(reinterpret_cast<const char *>(record.data()), static_cast<std::streamsize>(record.size()));
+        }
+
+        stream.flush();
+        return static_cast<bool>(stream);
+    }
+
+    std::optional<CaptureSnapshot> CaptureBuffer::Load(std::istream &stream)
+    {
+        std::array<uint8_t, HEADER_SIZE> header{};
+        if (!stream.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size()))
+            || std::memcmp(header.data(), CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size()) != 0
+            || (header[4] | (header[5] << 8)) != CAPTURE_VERSION)
+        {
+            return std::nullopt;
+        }
+
+        const uint32_t recordCount = GetU32(header.data() + 12);
+        const uint64_t sampleCount = GetU64(header.data() + 24);
+
+        // Reject counts the remaining data cannot hold before allocating
+        const std::streamoff position = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        const std::streamoff remaining = stream.tellg() - position;
+        stream.seekg(position);
+        if (position < 0 || remaining < 0 || sampleCount > static_cast<uint64_t>(remaining) / 4
+            || static_cast<uint64_t>(recordCount) * RECORD_SIZE > static_cast<uint64_t>(remaining) - sampleCount * 4)
+        {
+            return std::nullopt;
+        }
+
+        CaptureSnapshot snapshot{ GetF32(header.data() + 8), GetU64(header.data() + 16), {}, {} };
+        snapshot.samples.resize(static_cast<size_t>(sampleCount));
+
+        std::array<uint8_t, SAMPLE_BLOCK * 4> block{};
+        for (size_t read = 0; read < snapshot.samples.size();)
+        {
+            const size_t count = std::min(SAMPLE_BLOCK, snapshot.samples.size() - read);
+            if (!stream.read(reinterpret_cast<char *>(block.data()), static_cast<std::streamsize>(count * 4)))
+            {
+                return std::nullopt;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                snapshot.samples[read + i] = GetF32(block.data() + 4 * i);
+            }
+            read += count;
+        }
+
+        snapshot.frames.reserve(recordCount);
+        std::array<uint8_t, RECORD_SIZE> record{};
+        for (uint32_t i = 0; i < recordCount; ++i)
+        {
+            if (!stream.read(reinterpret_cast<char *>(record.data()), static_cast<std::streamsize>(record.size())))
+            {
+                return std::nullopt;
+            }
+
+            snapshot.frames.push_back(CaptureFrameRecord{ GetU64(record.data()), GetU32(record.data() + 16),
+                GetU64(record.data() + 8), { GetF32(record.data() + 24), GetF32(record.data() + 28) },
+                (GetU32(record.data() + 20) & FLAG_VALID) != 0 });
+        }
+
+        return snapshot;
+    }
+
+    void CaptureBuffer::Reset()
+    {
+        std::fill(samples.begin(), samples.end(), 0.0f);
+        samplesWritten = 0;
+        framesWritten = 0;
+        freezeState.store(FreezeState::Running, std::memory_order_release);
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,210 @@
+#include "CpuFeatures.h"
+#include "KernelDispatch.h"
+#include "kernels/KernelTables.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        std::atomic<const KernelTable *> activeKernels{ nullptr };
+
+        /**
+         * @brief Queries CPU (and OS register state) support for a level
+         */
+        bool CpuSupports(IsaLevel level)
+        {
+            switch (level)
+            {
+            case IsaLevel::Scalar:
+                return true;
+#if defined(GUITAR_DSP_HAVE_X86_KERNELS) && defined(_MSC_VER)
+            case IsaLevel::Sse2:
+            case IsaLevel::Avx2:
+            case IsaLevel::Avx512:
+            {
+                int info[4] = {};
+                __cpuid(info, 1);
+                const bool sse2 = (info[3] & (1 << 26)) != 0;
+                const bool fma = (info[2] & (1 << 12)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+                __cpuidex(info, 7, 0);
+                const bool avx2 = (info[1] & (1 << 5)) != 0;
+                const bool avx512f = (info[1] & (1 << 16)) != 0;
+
+                if (level == IsaLevel::Sse2)
+                {
+                    return sse2;
+                }
+                if (level == IsaLevel::Avx2)
+                {
+                    return avx2 && fma && (xcr0 & 0x6) == 0x6;
+                }
+                return avx512f && (xcr0 & 0xE6) == 0xE6;
+            }
+#elif defined(GUITAR_DSP_HAVE_X86_KERNELS)
+            case IsaLevel::Sse2:
+                return __builtin_cpu_supports("sse2");
+            case IsaLevel::Avx2:
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            case IsaLevel::Avx512:
+                return __builtin_cpu_supports("avx512f");
+#endif
+#if defined(GUITAR_DSP_HAVE_NEON_KERNELS)
+            case IsaLevel::Neon:
+                return true; // Mandatory on AArch64
+#endif
+            default:
+                return false;
+            }
+        }
+
+        const KernelTable *GetTable(IsaLevel level)
+        {
+            switch (level)
+            {
+#if defined(GUITAR_DSP_HAVE_X86_KERNELS)
+            case IsaLevel::Sse2:
+                return &Kernels::GetSse2Kernels();
+            case IsaLevel::Avx2:
+                return &Kernels::GetAvx2Kernels();
+            case IsaLevel::Avx512:
+                return &Kernels::GetAvx512Kernels();
+#endif
+#if defined(GUITAR_DSP_HAVE_NEON_KERNELS)
+            case IsaLevel::Neon:
+                return &Kernels::GetNeonKernels();
+#endif
+            case IsaLevel::Scalar:
+            default:
+                return &Kernels::GetScalarKernels();
+            }
+        }
+
+        /**
+         * @brief Parses GUITAR_DSP_ISA environment override
+         */
+        bool ReadEnvironmentOverride(IsaLevel &level)
+        {
+            const char *value = std::getenv("GUITAR_DSP_ISA");
+            if (value == nullptr)
+            {
+                return false;
+            }
+
+            for (const IsaLevel candidate :
+                 { IsaLevel::Scalar, IsaLevel::Sse2, IsaLevel::Avx2, IsaLevel::Avx512, IsaLevel::Neon })
+            {
+                if (std::strcmp(value, CpuFeatures::GetLevelName(candidate)) == 0)
+                {
+                    level = candidate;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        const KernelTable *SelectKernels()
+        {
+            IsaLevel level = CpuFeatures::DetectBestLevel();
+
+            IsaLevel requested = IsaLevel::Scalar;
+            if (ReadEnvironmentOverride(requested) && CpuFeatures::IsSupported(requested))
+            {
+                level = requested;
+            }
+
+            return GetTable(level);
+        }
+    } // namespace
+
+    bool CpuFeatures::IsSupported(IsaLevel level)
+    {
+        // Compiled-in check: GetTable falls back to scalar for missing levels
+        if (level != IsaLevel::Scalar && GetTable(level)->level != level)
+        {
+            return false;
+        }
+
+        return CpuSupports(level);
+    }
+
+    IsaLevel CpuFeatures::DetectBestLevel()
+    {
+        for (const IsaLevel level : { IsaLevel::Avx512, IsaLevel::Avx2, IsaLevel::Neon, IsaLevel::Sse2 })
+        {
+            if (IsSupported(level))
+            {
+                return level;
+            }
+        }
+
+        return IsaLevel::Scalar;
+    }
+
+    IsaLevel CpuFeatures::GetActiveLevel()
+    {
+        return GetKernels().level;
+    }
+
+    bool CpuFeatures::SetIsaOverride(IsaLevel level)
+    {
+        if (!IsSupported(level))
+        {
+            return false;
+        }
+
+        activeKernels.store(GetTable(level), std::memory_order_release);
+        return true;
+    }
+
+    void CpuFeatures::ClearIsaOverride()
+    {
+        activeKernels.store(SelectKernels(), std::memory_order_release);
+    }
+
+    const char *CpuFeatures::GetLevelName(IsaLevel level)
+    {
+        switch (level)
+        {
+        case IsaLevel::Scalar:
+            return "scalar";
+        case IsaLevel::Sse2:
+            return "sse2";
+        case IsaLevel::Avx2:
+            return "avx2";
+        case IsaLevel::Avx512:
+            return "avx512";
+        case IsaLevel::Neon:
+            return "neon";
+        default:
+            return "unknown";
+        }
+    }
+
+    const KernelTable &GetKernels()
+    {
+        const KernelTable *kernels = activeKernels.load(std::memory_order_acquire);
+        if (kernels == nullptr)
+        {
+            // Keep a table stored concurrently (racing first call or override)
+            const KernelTable *selected = SelectKernels();
+            kernels = activeKernels.compare_exchange_strong(kernels, selected, std::memory_order_acq_rel)
+                          ? selected
+                          : kernels;
+        }
+
+        return *kernels;
+    }
+
+} // namespace GuitarDSP
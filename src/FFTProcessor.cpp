@@ -1,8 +1,10 @@
 #include "FFTProcessor.h"
+#include "KernelDispatch.h"
 
 #include <pffft.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace GuitarDSP
@@ -52,19 +54,15 @@ namespace GuitarDSP
 
         maxBin = std::min(maxBin, fftSize / 2);
 
-        float bandEnergy = 0.0f;
-        for (size_t i = minBin; i <= maxBin; ++i)
+        // Bins [minBin, maxBin] are contiguous re/im pairs: their energy is a sum of squares
+        const size_t begin = std::min(minBin * 2, data.size());
+        const size_t end = std::min(maxBin * 2 + 2, data.size() & ~static_cast<size_t>(1));
+        if (begin >= end)
         {
-            size_t binIndex = i * 2;
-            if (binIndex + 1 < data.size())
-            {
-                float real = data[binIndex];
-                float imag = data[binIndex + 1];
-                bandEnergy += real * real + imag * imag;
-            }
+            return 0.0f;
         }
 
-        return bandEnergy;
+        return static_cast<float>(GetKernels().sumOfSquares(data.data() + begin, end - begin));
     }
 
     float FFTSpectrum::CalculateSpectralCentroid() const
@@ -79,18 +77,22 @@ namespace GuitarDSP
 
         float binWidth = sampleRate / static_cast<float>(fftSize);
 
-        for (size_t i = 0; i < fftSize / 2; ++i)
+        // Magnitudes are computed in blocks by the dispatched kernel (no allocation)
+        constexpr size_t blockSize = 256;
+        std::array<float, blockSize> magnitudes{};
+        const size_t binCount = std::min(fftSize / 2, data.size() / 2);
+        const KernelTable &kernels = GetKernels();
+
+        for (size_t blockStart = 0; blockStart < binCount; blockStart += blockSize)
         {
-            size_t binIndex = i * 2;
-            if (binIndex + 1 < data.size())
-            {
-                float real = data[binIndex];
-                float imag = data[binIndex + 1];
-                float magnitude = std::sqrt(real * real + imag * imag);
+            const size_t count = std::min(blockSize, binCount - blockStart);
+            kernels.complexMagnitude(data.data() + blockStart * 2, magnitudes.data(), count);
 
-                float frequency = static_cast<float>(i) * binWidth;
-                numerator += frequency * magnitude;
-                denominator += magnitude;
+            for (size_t i = 0; i < count; ++i)
+            {
+                float frequency = static_cast<float>(blockStart + i) * binWidth;
+                numerator += frequency * magnitudes[i];
+                denominator += magnitudes[i];
             }
         }
 
@@ -123,6 +125,19 @@ namespace GuitarDSP
 
     void FFTProcessor::ComputeSpectrum(std::span<const float> audioData)
     {
+        ComputeSpectrum(audioData, spectrum);
+    }
+
+    void FFTProcessor::ComputeSpectrum(std::span<const float> audioData, FFTSpectrum &output)
+    {
+        if (output.data.size() < inputBuffer.size())
+        {
+            return; // Resizing here would allocate
+        }
+
+        output.fftSize = spectrum.fftSize;
+        output.sampleRate = spectrum.sampleRate;
+
         size_t copySize = std::min(audioData.size(), inputBuffer.size());
         std::copy_n(audioData.begin(), copySize, inputBuffer.begin());
 
@@ -133,7 +148,7 @@ namespace GuitarDSP
 
         pffft_transform_ordered(static_cast<PFFFT_Setup *>(fftSetup),
             inputBuffer.data(),
-            spectrum.data.data(),
+            output.data.data(),
             workBuffer.data(),
             PFFFT_FORWARD);
     }
@@ -0,0 +1,43 @@
+#include "FrameClock.h"
+
+namespace GuitarDSP
+{
+    FrameClock::FrameClock(const FrameClockConfig &config) : config(config), startSample(0), nextHop(0)
+    {
+    }
+
+    FrameStamp FrameClock::NextFrame()
+    {
+        return GetFrame(nextHop++);
+    }
+
+    TimedPitchResult FrameClock::Stamp(const PitchResult &result)
+    {
+        return TimedPitchResult{ result, NextFrame() };
+    }
+
+    FrameStamp FrameClock::GetFrame(uint64_t hopIndex) const
+    {
+        const uint64_t frameStart = startSample + hopIndex * config.hopSize;
+        const double windowCentre = static_cast<double>(frameStart) + static_cast<double>(config.windowSize) * 0.5;
+
+        return FrameStamp{ frameStart, windowCentre, hopIndex };
+    }
+
+    double FrameClock::ToSeconds(double samplePosition) const
+    {
+        if (config.sampleRate <= 0.0f)
+        {
+            return 0.0;
+        }
+
+        return samplePosition / static_cast<double>(config.sampleRate);
+    }
+
+    void FrameClock::Reset(uint64_t startSample)
+    {
+        this->startSample = startSample;
+        nextHop = 0;
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,455 @@
+#include "GuitarDspCApi.h"
+
+#include "FFTProcessor.h"
+#include "HybridPitchDetector.h"
+#include "KernelDispatch.h"
+#include "MpmPitchDetector.h"
+#include "PitchStabilizer.h"
+#include "YinPitchDetector.h"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+using namespace GuitarDSP;
+
+struct gdsp_detector
+{
+    std::unique_ptr<PitchDetector> detector; ///< Wrapped detector
+    size_t maxBufferSize;                    ///< Largest accepted frame
+    gdsp_pitch_result lastResult;            ///< Result of most recent frame
+};
+
+struct gdsp_stabilizer
+{
+    std::unique_ptr<PitchStabilizer> stabilizer; ///< Wrapped stabilizer
+};
+
+struct gdsp_fft
+{
+    std::unique_ptr<FFTProcessor> processor; ///< Wrapped FFT processor
+    size_t fftSize;                          ///< FFT size (samples)
+};
+
+namespace
+{
+    constexpr gdsp_pitch_result NO_PITCH_RESULT = { 0.0f, 0.0f, 0 };
+
+    gdsp_pitch_result ToCResult(const std::optional<PitchResult> &result)
+    {
+        if (!result.has_value())
+        {
+            return NO_PITCH_RESULT;
+        }
+
+        return gdsp_pitch_result{ result->frequency, result->confidence, 1 };
+    }
+
+    /**
+     * @brief Returns true if PFFFT supports a real transform of this size
+     */
+    bool IsValidFftSize(size_t size)
+    {
+        if (size == 0 || size % 32 != 0)
+        {
+            return false;
+        }
+
+        for (const size_t factor : { 2u, 3u, 5u })
+        {
+            while (size % factor == 0)
+            {
+                size /= factor;
+            }
+        }
+
+        return size == 1;
+    }
+
+    std::unique_ptr<PitchDetector> MakeDetector(const gdsp_detector_config &config)
+    {
+        switch (config.type)
+        {
+        case GDSP_DETECTOR_YIN:
+        {
+            YinPitchDetectorConfig yinConfig;
+            yinConfig.minFrequency = config.min_frequency;
+            yinConfig.maxFrequency = config.max_frequency;
+            yinConfig.maxBufferSize = config.max_buffer_size;
+            if (config.threshold > 0.0f)
+            {
+                yinConfig.threshold = config.threshold;
+            }
+            return std::make_unique<YinPitchDetector>(yinConfig);
+        }
+        case GDSP_DETECTOR_MPM:
+        {
+            MpmPitchDetectorConfig mpmConfig;
+            mpmConfig.minFrequency = config.min_frequency;
+            mpmConfig.maxFrequency = config.max_frequency;
+            mpmConfig.maxBufferSize = config.max_buffer_size;
+            if (config.threshold > 0.0f)
+            {
+                mpmConfig.threshold = config.threshold;
+            }
+            return std::make_unique<MpmPitchDetector>(mpmConfig);
+        }
+        case GDSP_DETECTOR_HYBRID:
+        {
+            // The hybrid detector fixes its YIN range; only the MPM half takes the configured range
+            HybridPitchDetectorConfig hybridConfig;
+            hybridConfig.yinConfig.maxBufferSize = config.max_buffer_size;
+            hybridConfig.mpmConfig.minFrequency = config.min_frequency;
+            hybridConfig.mpmConfig.maxFrequency = config.max_frequency;
+            hybridConfig.mpmConfig.maxBufferSize = config.max_buffer_size;
+            if (config.threshold > 0.0f)
+            {
+                hybridConfig.yinConfidenceThreshold = config.threshold;
+            }
+            return std::make_unique<HybridPitchDetector>(hybridConfig);
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<PitchStabilizer> MakeStabilizer(const gdsp_stabilizer_config &config)
+    {
+        switch (config.type)
+        {
+        case GDSP_STABILIZER_EMA:
+            return std::make_unique<ExponentialMovingAverage>(EMAConfig{ config.alpha });
+        case GDSP_STABILIZER_MEDIAN:
+            return std::make_unique<MedianFilter>(MedianFilterConfig{ config.window_size });
+        case GDSP_STABILIZER_HYBRID:
+            return std::make_unique<HybridStabilizer>(HybridStabilizerConfig{ config.alpha, config.window_size });
+        default:
+            return nullptr;
+        }
+    }
+} // namespace
+
+extern "C"
+{
+    uint32_t gdsp_get_abi_version(void)
+    {
+        return GDSP_ABI_VERSION;
+    }
+
+    void gdsp_detector_config_init(gdsp_detector_config *config, gdsp_detector_type type)
+    {
+        if (config == nullptr)
+        {
+            return;
+        }
+
+        const YinPitchDetectorConfig defaults;
+        config->struct_size = sizeof(gdsp_detector_config);
+        config->type = type;
+        config->min_frequency = defaults.minFrequency;
+        config->max_frequency = defaults.maxFrequency;
+        config->threshold = 0.0f;
+        config->max_buffer_size = static_cast<uint32_t>(defaults.maxBufferSize);
+    }
+
+    gdsp_detector *gdsp_detector_create(const gdsp_detector_config *config)
+    {
+        if (config == nullptr || config->struct_size < sizeof(gdsp_detector_config) || config->min_frequency <= 0.0f
+            || config->max_frequency <= config->min_frequency || config->max_buffer_size == 0)
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            auto detector = MakeDetector(*config);
+            if (!detector)
+            {
+                return nullptr;
+            }
+
+            return new gdsp_detector{ std::move(detector), config->max_buffer_size, NO_PITCH_RESULT };
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void gdsp_detector_destroy(gdsp_detector *detector)
+    {
+        delete detector;
+    }
+
+    void gdsp_detector_reset(gdsp_detector *detector)
+    {
+        if (detector != nullptr)
+        {
+            detector->detector->Reset();
+            detector->lastResult = NO_PITCH_RESULT;
+        }
+    }
+
+    gdsp_status gdsp_detector_process(gdsp_detector *detector,
+        const float *samples,
+        size_t sample_count,
+        float sample_rate,
+        gdsp_pitch_result *result)
+    {
+        if (detector == nullptr || samples == nullptr || sample_count == 0 || sample_count > detector->maxBufferSize
+            || sample_rate <= 0.0f)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        detector->lastResult = ToCResult(detector->detector->Detect({ samples, sample_count }, sample_rate));
+        if (result != nullptr)
+        {
+            *result = detector->lastResult;
+        }
+
+        return detector->lastResult.valid ? GDSP_OK : GDSP_NO_PITCH;
+    }
+
+    gdsp_status gdsp_detector_process_frames(gdsp_detector *detector,
+        const float *signal,
+        size_t signal_length,
+        size_t frame_size,
+        size_t hop_size,
+        float sample_rate,
+        gdsp_pitch_result *results,
+        size_t max_results,
+        size_t *frames_written)
+    {
+        if (frames_written != nullptr)
+        {
+            *frames_written = 0;
+        }
+
+        if (detector == nullptr || signal == nullptr || results == nullptr || frame_size == 0 || hop_size == 0
+            || frame_size > detector->maxBufferSize || sample_rate <= 0.0f)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        const size_t frameCount = signal_length >= frame_size ? (signal_length - frame_size) / hop_size + 1 : 0;
+        const size_t processed = std::min(frameCount, max_results);
+
+        for (size_t frame = 0; frame < processed; ++frame)
+        {
+            const std::span<const float> samples(signal + frame * hop_size, frame_size);
+            results[frame] = ToCResult(detector->detector->Detect(samples, sample_rate));
+        }
+
+        if (processed > 0)
+        {
+            detector->lastResult = results[processed - 1];
+        }
+
+        if (frames_written != nullptr)
+        {
+            *frames_written = processed;
+        }
+
+        return processed < frameCount ? GDSP_ERROR_BUFFER_TOO_SMALL : GDSP_OK;
+    }
+
+    gdsp_status gdsp_detector_get_result(const gdsp_detector *detector, gdsp_pitch_result *result)
+    {
+        if (detector == nullptr || result == nullptr)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        *result = detector->lastResult;
+        return result->valid ? GDSP_OK : GDSP_NO_PITCH;
+    }
+
+    void gdsp_stabilizer_config_init(gdsp_stabilizer_config *config, gdsp_stabilizer_type type)
+    {
+        if (config == nullptr)
+        {
+            return;
+        }
+
+        const HybridStabilizerConfig defaults;
+        config->struct_size = sizeof(gdsp_stabilizer_config);
+        config->type = type;
+        config->alpha = defaults.baseAlpha;
+        config->window_size = defaults.windowSize;
+    }
+
+    gdsp_stabilizer *gdsp_stabilizer_create(const gdsp_stabilizer_config *config)
+    {
+        if (config == nullptr || config->struct_size < sizeof(gdsp_stabilizer_config) || config->alpha <= 0.0f
+            || config->alpha > 1.0f || config->window_size == 0)
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            auto stabilizer = MakeStabilizer(*config);
+            if (!stabilizer)
+            {
+                return nullptr;
+            }
+
+            return new gdsp_stabilizer{ std::move(stabilizer) };
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void gdsp_stabilizer_destroy(gdsp_stabilizer *stabilizer)
+    {
+        delete stabilizer;
+    }
+
+    void gdsp_stabilizer_reset(gdsp_stabilizer *stabilizer)
+    {
+        if (stabilizer != nullptr)
+        {
+            stabilizer->stabilizer->Reset();
+        }
+    }
+
+    gdsp_status gdsp_stabilizer_update(gdsp_stabilizer *stabilizer,
+        const gdsp_pitch_result *results,
+        size_t count,
+        gdsp_pitch_result *stabilized)
+    {
+        if (stabilizer == nullptr || (results == nullptr && count > 0))
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (results[i].valid)
+            {
+                stabilizer->stabilizer->Update(PitchResult{ results[i].frequency, results[i].confidence });
+            }
+
+            if (stabilized != nullptr)
+            {
+                const PitchResult current = stabilizer->stabilizer->GetStabilized();
+                stabilized[i] = gdsp_pitch_result{ current.frequency, current.confidence, current.frequency > 0.0f };
+            }
+        }
+
+        return GDSP_OK;
+    }
+
+    gdsp_status gdsp_stabilizer_get_result(const gdsp_stabilizer *stabilizer, gdsp_pitch_result *result)
+    {
+        if (stabilizer == nullptr || result == nullptr)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        const PitchResult current = stabilizer->stabilizer->GetStabilized();
+        *result = gdsp_pitch_result{ current.frequency, current.confidence, current.frequency > 0.0f };
+        return result->valid ? GDSP_OK : GDSP_NO_PITCH;
+    }
+
+    float gdsp_stabilizer_get_group_delay(const gdsp_stabilizer *stabilizer)
+    {
+        return stabilizer != nullptr ? stabilizer->stabilizer->GetGroupDelay() : 0.0f;
+    }
+
+    gdsp_fft *gdsp_fft_create(size_t fft_size, float sample_rate)
+    {
+        if (!IsValidFftSize(fft_size) || sample_rate <= 0.0f)
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            return new gdsp_fft{ std::make_unique<FFTProcessor>(fft_size, sample_rate), fft_size };
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void gdsp_fft_destroy(gdsp_fft *fft)
+    {
+        delete fft;
+    }
+
+    size_t gdsp_fft_get_bin_count(const gdsp_fft *fft)
+    {
+        return fft != nullptr ? fft->fftSize / 2 : 0;
+    }
+
+    gdsp_status gdsp_fft_process(gdsp_fft *fft, const float *samples, size_t sample_count)
+    {
+        if (fft == nullptr || samples == nullptr)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        fft->processor->ComputeSpectrum({ samples, sample_count });
+        return GDSP_OK;
+    }
+
+    gdsp_status gdsp_fft_get_magnitudes(const gdsp_fft *fft, float *magnitudes, size_t bin_count)
+    {
+        if (fft == nullptr || magnitudes == nullptr)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        if (bin_count < fft->fftSize / 2)
+        {
+            return GDSP_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        GetKernels().complexMagnitude(fft->processor->GetSpectrum().data.data(), magnitudes, fft->fftSize / 2);
+        return GDSP_OK;
+    }
+
+    gdsp_status gdsp_fft_process_frames(gdsp_fft *fft,
+        const float *signal,
+        size_t signal_length,
+        size_t hop_size,
+        float *magnitudes,
+        size_t max_frames,
+        size_t *frames_written)
+    {
+        if (frames_written != nullptr)
+        {
+            *frames_written = 0;
+        }
+
+        if (fft == nullptr || signal == nullptr || magnitudes == nullptr || hop_size == 0)
+        {
+            return GDSP_ERROR_INVALID_ARGUMENT;
+        }
+
+        const size_t frameSize = fft->fftSize;
+        const size_t binCount = frameSize / 2;
+        const size_t frameCount = signal_length >= frameSize ? (signal_length - frameSize) / hop_size + 1 : 0;
+        const size_t processed = std::min(frameCount, max_frames);
+        const KernelTable &kernels = GetKernels();
+
+        for (size_t frame = 0; frame < processed; ++frame)
+        {
+            fft->processor->ComputeSpectrum({ signal + frame * hop_size, frameSize });
+            const float *spectrum = fft->processor->GetSpectrum().data.data();
+            kernels.complexMagnitude(spectrum, magnitudes + frame * binCount, binCount);
+        }
+
+        if (frames_written != nullptr)
+        {
+            *frames_written = processed;
+        }
+
+        return processed < frameCount ? GDSP_ERROR_BUFFER_TOO_SMALL : GDSP_OK;
+    }
+}
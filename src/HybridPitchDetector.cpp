@@ -1,4 +1,5 @@
 #include "HybridPitchDetector.h"
+#include "StageProfiler.h"
 #include <cmath>
 
 namespace GuitarDSP
@@ -35,7 +36,11 @@ namespace GuitarDSP
         }
 
         // Try YIN first (faster)
-        auto yinResult = yinDetector->Detect(buffer, sampleRate);
+        std::optional<PitchResult> yinResult;
+        {
+            GUITAR_DSP_PROFILE_STAGE(ProfileStage::HybridYin);
+            yinResult = yinDetector->Detect(buffer, sampleRate);
+        }
 
         std::optional<PitchResult> finalResult = std::nullopt;
 
@@ -48,7 +53,11 @@ namespace GuitarDSP
         else
         {
             // YIN not confident, try MPM
-            auto mpmResult = mpmDetector->Detect(buffer, sampleRate);
+            std::optional<PitchResult> mpmResult;
+            {
+                GUITAR_DSP_PROFILE_STAGE(ProfileStage::HybridMpm);
+                mpmResult = mpmDetector->Detect(buffer, sampleRate);
+            }
 
             if (mpmResult.has_value())
             {
@@ -67,6 +76,7 @@ namespace GuitarDSP
         // Apply harmonic rejection if enabled
         if (finalResult.has_value() && config.enableHarmonicRejection)
         {
+            GUITAR_DSP_PROFILE_STAGE(ProfileStage::HybridHarmonicRejection);
             float correctedFreq = ApplyHarmonicRejection(finalResult->frequency);
             if (std::abs(correctedFreq - finalResult->frequency) > 0.1f)
             {
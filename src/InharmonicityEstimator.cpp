@@ -0,0 +1,233 @@
+#include "InharmonicityEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarDSP
+{
+    InharmonicityEstimator::InharmonicityEstimator(const InharmonicityEstimatorConfig &config)
+        : config(config), partials({}), partialCount(0)
+    {
+        // Pre-allocate partial table (real-time safe)
+        partials.resize(config.maxPartials, Partial{ 0, 0.0f, 0.0f });
+    }
+
+    std::optional<InharmonicityResult> InharmonicityEstimator::Estimate(const FFTSpectrum &spectrum,
+        float coarseFundamental)
+    {
+        partialCount = 0;
+
+        if (coarseFundamental <= 0.0f || spectrum.sampleRate <= 0.0f || spectrum.fftSize == 0)
+        {
+            return std::nullopt;
+        }
+
+        const uint32_t minPartials = std::max<uint32_t>(config.minPartials, 2);
+        const uint32_t passes = std::max<uint32_t>(config.iterations, 1);
+
+        float fundamental = coarseFundamental;
+        float inharmonicity = 0.0f;
+
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            const uint32_t found = LocatePartials(spectrum, fundamental, inharmonicity);
+            if (found < minPartials)
+            {
+                partialCount = 0;
+                return std::nullopt;
+            }
+
+            // Weighted linear least squares: y = a + b * x
+            // x = n^2, y = (f_n / n)^2, a = f0^2, b = f0^2 * B
+            double sumW = 0.0;
+            double sumWX = 0.0;
+            double sumWY = 0.0;
+            double sumWXX = 0.0;
+            double sumWXY = 0.0;
+
+            for (uint32_t i = 0; i < found; ++i)
+            {
+                const auto n = static_cast<double>(partials[i].number);
+                const double x = n * n;
+                const double ratio = static_cast<double>(partials[i].frequency) / n;
+                const double y = ratio * ratio;
+                const auto w = static_cast<double>(partials[i].magnitude);
+
+                sumW += w;
+                sumWX += w * x;
+                sumWY += w * y;
+                sumWXX += w * x * x;
+                sumWXY += w * x * y;
+            }
+
+            if (sumW <= 0.0)
+            {
+                partialCount = 0;
+                return std::nullopt;
+            }
+
+            const double determinant = sumW * sumWXX - sumWX * sumWX;
+            double slope = 0.0;
+            if (std::abs(determinant) > 1e-12 * sumW * sumWXX)
+            {
+                slope = (sumW * sumWXY - sumWX * sumWY) / determinant;
+            }
+            const double intercept = (sumWY - slope * sumWX) / sumW;
+
+            if (intercept <= 0.0)
+            {
+                partialCount = 0;
+                return std::nullopt;
+            }
+
+            const auto fittedInharmonicity = static_cast<float>(slope / intercept);
+            inharmonicity = std::clamp(fittedInharmonicity, 0.0f, config.maxInharmonicity);
+            fundamental = static_cast<float>(std::sqrt(intercept));
+
+            if (inharmonicity != fittedInharmonicity)
+            {
+                // Clamped B no longer matches the intercept: refit f0 with B fixed (f_n / n for B = 0)
+                double sumWF = 0.0;
+                for (uint32_t i = 0; i < found; ++i)
+                {
+                    const auto n = static_cast<double>(partials[i].number);
+                    const double stretch = std::sqrt(1.0 + static_cast<double>(inharmonicity) * n * n);
+                    sumWF += static_cast<double>(partials[i].magnitude) * static_cast<double>(partials[i].frequency)
+                             / (n * stretch);
+                }
+                fundamental = static_cast<float>(sumWF / sumW);
+            }
+
+            partialCount = found;
+        }
+
+        // RMS deviation of measured partials from fitted model
+        float squaredResidual = 0.0f;
+        for (uint32_t i = 0; i < partialCount; ++i)
+        {
+            const auto n = static_cast<float>(partials[i].number);
+            const float predicted = n * fundamental * std::sqrt(1.0f + inharmonicity * n * n);
+            const float cents = 1200.0f * std::log2(partials[i].frequency / predicted);
+            squaredResidual += cents * cents;
+        }
+
+        const float residualCents = std::sqrt(squaredResidual / static_cast<float>(partialCount));
+
+        return InharmonicityResult{ fundamental, inharmonicity, partialCount, residualCents };
+    }
+
+    std::span<const Partial> InharmonicityEstimator::GetPartials() const
+    {
+        return std::span<const Partial>(partials.data(), partialCount);
+    }
+
+    void InharmonicityEstimator::Reset()
+    {
+        partialCount = 0;
+        std::fill(partials.begin(), partials.end(), Partial{ 0, 0.0f, 0.0f });
+    }
+
+    uint32_t InharmonicityEstimator::LocatePartials(const FFTSpectrum &spectrum,
+        float fundamental,
+        float inharmonicity)
+    {
+        const float nyquist = spectrum.sampleRate * 0.5f;
+        const float upperLimit = std::min(config.maxFrequency, nyquist);
+
+        uint32_t found = 0;
+        float strongest = 0.0f;
+
+        for (uint32_t n = 1; n <= config.maxPartials && found < partials.size(); ++n)
+        {
+            const auto harmonic = static_cast<float>(n);
+            const float predicted = harmonic * fundamental * std::sqrt(1.0f + inharmonicity * harmonic * harmonic);
+            if (predicted >= upperLimit)
+            {
+                break;
+            }
+
+            float peakFrequency = 0.0f;
+            float peakMagnitude = 0.0f;
+            if (FindPeak(spectrum, predicted, peakFrequency, peakMagnitude))
+            {
+                partials[found] = Partial{ n, peakFrequency, peakMagnitude };
+                strongest = std::max(strongest, peakMagnitude);
+                ++found;
+            }
+        }
+
+        // Discard weak partials (noise peaks) in place
+        const float minMagnitude = strongest * config.minRelativeMagnitude;
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < found; ++i)
+        {
+            if (partials[i].magnitude >= minMagnitude && partials[i].magnitude > 0.0f)
+            {
+                partials[kept++] = partials[i];
+            }
+        }
+
+        return kept;
+    }
+
+    bool InharmonicityEstimator::FindPeak(const FFTSpectrum &spectrum,
+        float frequency,
+        float &peakFrequency,
+        float &peakMagnitude) const
+    {
+        if (spectrum.fftSize < 8)
+        {
+            return false;
+        }
+
+        const float binWidth = spectrum.sampleRate / static_cast<float>(spectrum.fftSize);
+        const float spread = std::exp2(config.searchToleranceCents / 1200.0f);
+
+        const size_t lastBin = spectrum.fftSize / 2 - 1;
+        const auto highBinEstimate = static_cast<size_t>(std::ceil(frequency * spread / binWidth));
+
+        // Bin 0 is skipped: it holds DC / Nyquist in PFFFT's ordered layout
+        const auto lowBin = std::max<size_t>(static_cast<size_t>(frequency / spread / binWidth), 2);
+        const auto highBin = std::min<size_t>(highBinEstimate, lastBin - 1);
+
+        if (lowBin > highBin)
+        {
+            return false;
+        }
+
+        size_t bestBin = 0;
+        float bestMagnitude = 0.0f;
+        for (size_t bin = lowBin; bin <= highBin; ++bin)
+        {
+            const float magnitude = spectrum.GetMagnitudeAtBin(bin);
+            if (magnitude > bestMagnitude && magnitude >= spectrum.GetMagnitudeAtBin(bin - 1)
+                && magnitude >= spectrum.GetMagnitudeAtBin(bin + 1))
+            {
+                bestMagnitude = magnitude;
+                bestBin = bin;
+            }
+        }
+
+        if (bestBin == 0)
+        {
+            return false;
+        }
+
+        // Parabolic interpolation on log magnitude for sub-bin accuracy
+        const float s0 = std::log(spectrum.GetMagnitudeAtBin(bestBin - 1) + 1e-12f);
+        const float s1 = std::log(bestMagnitude + 1e-12f);
+        const float s2 = std::log(spectrum.GetMagnitudeAtBin(bestBin + 1) + 1e-12f);
+
+        float adjustment = 0.0f;
+        const float denominator = 2.0f * s1 - s0 - s2;
+        if (denominator > 0.0f)
+        {
+            adjustment = std::clamp(0.5f * (s2 - s0) / denominator, -0.5f, 0.5f);
+        }
+
+        peakFrequency = (static_cast<float>(bestBin) + adjustment) * binWidth;
+        peakMagnitude = std::exp(s1 - 0.25f * (s0 - s2) * adjustment);
+
+        return true;
+    }
+
+} // namespace GuitarDSP
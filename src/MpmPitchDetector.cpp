@@ -1,23 +1,44 @@
 #include "MpmPitchDetector.h"
+#include "StageProfiler.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <type_traits>
 
 namespace GuitarDSP
 {
+    namespace
+    {
+        /**
+         * @brief Policy the sliding lagged energy is carried in
+         *
+         * Double and compensated sums are exact enough to update one lag at a
+         * time; a float running sum drifts over hundreds of lags, so the Float
+         * policy carries it in double instead.
+         */
+        template<typename Policy>
+        using LaggedEnergyPolicy
+            = std::conditional_t<std::is_same_v<Policy, FloatAccumulation>, DoubleAccumulation, Policy>;
+    } // namespace
 
     MpmPitchDetector::MpmPitchDetector(const MpmPitchDetectorConfig &config)
-        : config(config), nsdfBuffer({}), acfBuffer({}), rBuffer({})
+        : config(config), nsdfBuffer({}), acfBuffer({}), rBuffer({}), nsdfSize(0)
     {
+        // Pre-allocate buffers (real-time safe)
+        const size_t maxHalfSize = config.maxBufferSize / 2;
+        nsdfBuffer.resize(maxHalfSize, 0.0f);
+        acfBuffer.resize(maxHalfSize, 0.0f);
+        rBuffer.resize(maxHalfSize, 0.0f);
     }
 
     MpmPitchDetector::~MpmPitchDetector() = default;
 
     void MpmPitchDetector::Reset()
     {
-        nsdfBuffer.clear();
-        acfBuffer.clear();
-        rBuffer.clear();
+        std::fill(nsdfBuffer.begin(), nsdfBuffer.end(), 0.0f);
+        std::fill(acfBuffer.begin(), acfBuffer.end(), 0.0f);
+        std::fill(rBuffer.begin(), rBuffer.end(), 0.0f);
+        nsdfSize = 0;
     }
 
     std::optional<PitchResult> MpmPitchDetector::Detect(std::span<const float> buffer, float sampleRate)
@@ -37,39 +58,60 @@ namespace GuitarDSP
             return std::nullopt; // Buffer too small
         }
 
-        // Resize buffers if needed
+        // Verify pre-allocated buffers are sufficient (no allocation on the audio thread)
         const size_t halfSize = bufferSize / 2;
-        if (nsdfBuffer.size() != halfSize)
+        if (halfSize > nsdfBuffer.size())
         {
-            nsdfBuffer.resize(halfSize);
-            acfBuffer.resize(halfSize);
-            rBuffer.resize(halfSize);
+            return std::nullopt; // Increase config.maxBufferSize
         }
+        nsdfSize = halfSize;
 
-        // Compute NSDF
-        ComputeNSDF(buffer);
-
-        // Find peaks in NSDF
-        auto peaks = FindPeaks();
-
-        if (peaks.empty())
+        int maxTauPeak = -1;
+        if (config.lazyEvaluation)
         {
-            return std::nullopt;
+            switch (config.precision)
+            {
+            case AccumulationPrecision::Double:
+                maxTauPeak = FindKeyMaximumLazy<DoubleAccumulation>(buffer, maxTau);
+                break;
+            case AccumulationPrecision::Compensated:
+                maxTauPeak = FindKeyMaximumLazy<CompensatedAccumulation>(buffer, maxTau);
+                break;
+            case AccumulationPrecision::Float:
+            default:
+                maxTauPeak = FindKeyMaximumLazy<FloatAccumulation>(buffer, maxTau);
+                break;
+            }
         }
-
-        // Get highest peak
-        int maxTauPeak = peaks[0];
-        float maxValue = nsdfBuffer[maxTauPeak];
-
-        for (int peak : peaks)
+        else
         {
-            if (nsdfBuffer[peak] > maxValue)
+            // Compute NSDF
+            switch (config.precision)
             {
-                maxValue = nsdfBuffer[peak];
-                maxTauPeak = peak;
+            case AccumulationPrecision::Double:
+                ComputeNSDF<DoubleAccumulation>(buffer);
+                break;
+            case AccumulationPrecision::Compensated:
+                ComputeNSDF<CompensatedAccumulation>(buffer);
+                break;
+            case AccumulationPrecision::Float:
+            default:
+                ComputeNSDF<FloatAccumulation>(buffer);
+                break;
             }
+
+            // Find highest peak in NSDF
+            GUITAR_DSP_PROFILE_STAGE(ProfileStage::MpmPeakPicking);
+            maxTauPeak = FindBestPeak();
+        }
+
+        if (maxTauPeak < 0)
+        {
+            return std::nullopt;
         }
 
+        const float maxValue = nsdfBuffer[maxTauPeak];
+
         // Refine with parabolic interpolation
         float refinedTau = ParabolicInterpolation(maxTauPeak);
 
@@ -86,35 +128,36 @@ namespace GuitarDSP
         return PitchResult{ frequency, confidence };
     }
 
+    template<typename Policy>
     void MpmPitchDetector::ComputeNSDF(std::span<const float> buffer)
     {
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::MpmNsdf);
         const size_t bufferSize = buffer.size();
         const size_t halfSize = bufferSize / 2;
+        const auto window = buffer.first(halfSize);
 
         // Compute autocorrelation (ACF) using time-domain method
         for (size_t tau = 0; tau < halfSize; ++tau)
         {
-            float sum = 0.0f;
-            for (size_t j = 0; j < halfSize; ++j)
-            {
-                sum += buffer[j] * buffer[j + tau];
-            }
-            acfBuffer[tau] = sum;
+            acfBuffer[tau] = static_cast<float>(DotProduct<Policy>(window, buffer.subspan(tau, halfSize)));
         }
 
         // Compute r(tau) = sum of squares for normalization
+        // The lagged energy slides by one sample per lag, so it is updated
+        // incrementally instead of re-summed (see LaggedEnergyPolicy).
+        using EnergyPolicy = LaggedEnergyPolicy<Policy>;
+        const double windowEnergy = SumOfSquares<Policy>(window);
+        typename EnergyPolicy::Accumulator laggedEnergy;
+        laggedEnergy.Add(static_cast<typename EnergyPolicy::Term>(windowEnergy));
+
         for (size_t tau = 0; tau < halfSize; ++tau)
         {
-            float sum1 = 0.0f;
-            float sum2 = 0.0f;
-
-            for (size_t j = 0; j < halfSize; ++j)
-            {
-                sum1 += buffer[j] * buffer[j];
-                sum2 += buffer[j + tau] * buffer[j + tau];
-            }
+            rBuffer[tau] = static_cast<float>(windowEnergy + laggedEnergy.Value());
 
-            rBuffer[tau] = sum1 + sum2;
+            using Term = typename EnergyPolicy::Term;
+            const auto leaving = static_cast<Term>(buffer[tau]);
+            const auto entering = static_cast<Term>(buffer[tau + halfSize]);
+            laggedEnergy.Add(entering * entering - leaving * leaving);
         }
 
         // Compute NSDF = 2 * ACF(tau) / r(tau)
@@ -131,57 +174,124 @@ namespace GuitarDSP
         }
     }
 
-    std::vector<int> MpmPitchDetector::FindPeaks()
+    template<typename Policy>
+    int MpmPitchDetector::FindKeyMaximumLazy(std::span<const float> buffer, size_t maxTau)
     {
-        std::vector<int> peaks;
-        const size_t halfSize = nsdfBuffer.size();
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::MpmNsdf);
+        const size_t halfSize = nsdfSize;
+        const auto window = buffer.first(halfSize);
+
+        // Same incremental lagged energy as ComputeNSDF
+        using EnergyPolicy = LaggedEnergyPolicy<Policy>;
+        const double windowEnergy = SumOfSquares<Policy>(window);
+        typename EnergyPolicy::Accumulator laggedEnergy;
+        laggedEnergy.Add(static_cast<typename EnergyPolicy::Term>(windowEnergy));
+
+        bool seenNegative = false;
+        bool inRegion = false;
+        int regionTau = -1;
+        float regionValue = 0.0f;
+        float runningMax = 0.0f;
 
-        // Find positive zero crossings
-        std::vector<int> zeroCrossings;
-        for (size_t i = 1; i < halfSize; ++i)
+        for (size_t tau = 0; tau < halfSize; ++tau)
         {
-            if (nsdfBuffer[i - 1] <= 0.0f && nsdfBuffer[i] > 0.0f)
+            const auto acf = static_cast<float>(DotProduct<Policy>(window, buffer.subspan(tau, halfSize)));
+            const auto r = static_cast<float>(windowEnergy + laggedEnergy.Value());
+            nsdfBuffer[tau] = r > 0.0f ? (2.0f * acf) / r : 0.0f;
+
+            using Term = typename EnergyPolicy::Term;
+            const auto leaving = static_cast<Term>(buffer[tau]);
+            const auto entering = static_cast<Term>(buffer[tau + halfSize]);
+            laggedEnergy.Add(entering * entering - leaving * leaving);
+
+            const float value = nsdfBuffer[tau];
+            if (value > 0.0f)
             {
-                zeroCrossings.push_back(static_cast<int>(i));
+                if (seenNegative && !inRegion)
+                {
+                    // Positive-going zero crossing opens a key maximum region
+                    inRegion = true;
+                    regionTau = static_cast<int>(tau);
+                    regionValue = value;
+                }
+                else if (inRegion && value > regionValue)
+                {
+                    regionTau = static_cast<int>(tau);
+                    regionValue = value;
+                }
+                continue;
             }
-        }
 
-        if (zeroCrossings.size() < 2)
-        {
-            return peaks;
+            seenNegative = true;
+            if (inRegion)
+            {
+                // Negative-going zero crossing confirms the key maximum of the region
+                inRegion = false;
+                if (regionValue >= config.smallCutoff)
+                {
+                    runningMax = std::max(runningMax, regionValue);
+                    if (regionValue >= config.threshold && regionValue >= config.cutoff * runningMax)
+                    {
+                        return regionTau;
+                    }
+                }
+            }
+
+            if (tau >= maxTau)
+            {
+                break; // Any later key maximum is below minFrequency
+            }
         }
 
-        for (size_t i = 0; i < zeroCrossings.size() - 1; ++i)
-        {
-            int start = zeroCrossings[i];
-            int end = zeroCrossings[i + 1];
+        return -1;
+    }
+
+    int MpmPitchDetector::FindBestPeak() const
+    {
+        const size_t halfSize = nsdfSize;
 
-            // Find maximum in this region
-            int maxIdx = start;
-            float maxVal = nsdfBuffer[start];
+        // Scan regions between consecutive positive zero crossings
+        int bestTau = -1;
+        float bestValue = 0.0f;
+        int regionStart = -1;
 
-            for (int j = start + 1; j < end; ++j)
+        for (size_t i = 1; i < halfSize; ++i)
+        {
+            if (nsdfBuffer[i - 1] <= 0.0f && nsdfBuffer[i] > 0.0f)
             {
-                if (nsdfBuffer[j] > maxVal)
+                if (regionStart >= 0)
                 {
-                    maxVal = nsdfBuffer[j];
-                    maxIdx = j;
+                    // Find maximum in this region
+                    int maxIdx = regionStart;
+                    float maxVal = nsdfBuffer[regionStart];
+
+                    for (int j = regionStart + 1; j < static_cast<int>(i); ++j)
+                    {
+                        if (nsdfBuffer[j] > maxVal)
+                        {
+                            maxVal = nsdfBuffer[j];
+                            maxIdx = j;
+                        }
+                    }
+
+                    // Only keep peaks above threshold
+                    if (maxVal >= config.threshold && (bestTau < 0 || maxVal > bestValue))
+                    {
+                        bestValue = maxVal;
+                        bestTau = maxIdx;
+                    }
                 }
-            }
 
-            // Only keep peaks above threshold
-            if (maxVal >= config.threshold)
-            {
-                peaks.push_back(maxIdx);
+                regionStart = static_cast<int>(i);
             }
         }
 
-        return peaks;
+        return bestTau;
     }
 
     float MpmPitchDetector::ParabolicInterpolation(int tau)
     {
-        const size_t halfSize = nsdfBuffer.size();
+        const size_t halfSize = nsdfSize;
 
         if (tau <= 0 || tau >= static_cast<int>(halfSize) - 1)
         {
@@ -0,0 +1,38 @@
+#include "PipelineLatency.h"
+#include <algorithm>
+
+namespace GuitarDSP
+{
+    LatencyReport PipelineLatency::Compute(const PipelineLatencyConfig &config)
+    {
+        LatencyReport report{};
+
+        // Window-based estimates describe the window centre
+        report.windowDelay = static_cast<float>(config.windowSize) * 0.5f;
+
+        // An event may arrive just after a frame was taken
+        report.hopDelay = static_cast<float>(config.hopSize > 0 ? config.hopSize - 1 : 0);
+
+        report.prefilterDelay = std::max(config.prefilterGroupDelay, 0.0f);
+        report.decimatorDelay = config.decimationFactor > 1 ? std::max(config.decimatorGroupDelay, 0.0f) : 0.0f;
+
+        // Stabilizers delay by whole frames
+        report.stabilizerDelay = 0.0f;
+        if (config.stabilizer != nullptr)
+        {
+            report.stabilizerDelay = config.stabilizer->GetGroupDelay() * static_cast<float>(config.hopSize);
+        }
+
+        report.totalSamples = report.windowDelay + report.hopDelay + report.prefilterDelay + report.decimatorDelay
+                              + report.stabilizerDelay;
+
+        report.totalMilliseconds = 0.0f;
+        if (config.sampleRate > 0.0f)
+        {
+            report.totalMilliseconds = 1000.0f * report.totalSamples / config.sampleRate;
+        }
+
+        return report;
+    }
+
+} // namespace GuitarDSP
@@ -1,6 +1,7 @@
 #include "PitchStabilizer.h"
 #include <algorithm>
 #include <cmath>
+#include <span>
 
 namespace GuitarDSP
 {
@@ -36,10 +37,24 @@ namespace GuitarDSP
         initialized = false;
     }
 
-    MedianFilter::MedianFilter(const MedianFilterConfig &config) : config(config), writeIndex(0), sampleCount(0)
+    float ExponentialMovingAverage::GetGroupDelay() const
     {
-        // Pre-allocate window buffer (real-time safe)
+        // Low-frequency group delay of y[n] = a*x[n] + (1-a)*y[n-1]
+        if (config.alpha <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        return (1.0f - std::min(config.alpha, 1.0f)) / config.alpha;
+    }
+
+    MedianFilter::MedianFilter(const MedianFilterConfig &config)
+        : config(config), median{ 0.0f, 0.0f }, writeIndex(0), sampleCount(0)
+    {
+        // Pre-allocate window and sort scratch buffers (real-time safe)
         window.resize(config.windowSize, { 0.0f, 0.0f });
+        frequencyScratch.resize(config.windowSize, 0.0f);
+        confidenceScratch.resize(config.windowSize, 0.0f);
     }
 
     void MedianFilter::Update(const PitchResult &result)
@@ -52,62 +67,71 @@ namespace GuitarDSP
         {
             sampleCount++;
         }
+
+        median = ComputeMedian();
     }
 
     PitchResult MedianFilter::GetStabilized() const
     {
-        return ComputeMedian();
+        return median;
     }
 
     void MedianFilter::Reset()
     {
         writeIndex = 0;
         sampleCount = 0;
+        median = { 0.0f, 0.0f };
         std::fill(window.begin(), window.end(), PitchResult{ 0.0f, 0.0f });
     }
 
-    PitchResult MedianFilter::ComputeMedian() const
+    float MedianFilter::GetGroupDelay() const
+    {
+        // Median of a full window lags the newest sample by half the window
+        if (config.windowSize == 0)
+        {
+            return 0.0f;
+        }
+
+        return static_cast<float>(config.windowSize - 1) * 0.5f;
+    }
+
+    PitchResult MedianFilter::ComputeMedian()
     {
         if (sampleCount == 0)
         {
             return { 0.0f, 0.0f };
         }
 
-        // Create sorted copies for median calculation (not real-time safe, but small arrays)
-        std::vector<float> frequencies;
-        std::vector<float> confidences;
-
-        frequencies.reserve(sampleCount);
-        confidences.reserve(sampleCount);
+        // Sort copies of active samples in pre-allocated scratch buffers
+        auto frequencies = std::span<float>(frequencyScratch).first(sampleCount);
+        auto confidences = std::span<float>(confidenceScratch).first(sampleCount);
 
-        // Copy active samples
         for (uint32_t i = 0; i < sampleCount; ++i)
         {
-            frequencies.push_back(window[i].frequency);
-            confidences.push_back(window[i].confidence);
+            frequencies[i] = window[i].frequency;
+            confidences[i] = window[i].confidence;
         }
 
-        // Sort and find median
         std::sort(frequencies.begin(), frequencies.end());
         std::sort(confidences.begin(), confidences.end());
 
         uint32_t midIndex = sampleCount / 2;
 
-        PitchResult median;
+        PitchResult result;
         if (sampleCount % 2 == 0)
         {
             // Even count: average of two middle values
-            median.frequency = (frequencies[midIndex - 1] + frequencies[midIndex]) * 0.5f;
-            median.confidence = (confidences[midIndex - 1] + confidences[midIndex]) * 0.5f;
+            result.frequency = (frequencies[midIndex - 1] + frequencies[midIndex]) * 0.5f;
+            result.confidence = (confidences[midIndex - 1] + confidences[midIndex]) * 0.5f;
         }
         else
         {
             // Odd count: middle value
-            median.frequency = frequencies[midIndex];
-            median.confidence = confidences[midIndex];
+            result.frequency = frequencies[midIndex];
+            result.confidence = confidences[midIndex];
         }
 
-        return median;
+        return result;
     }
 
     HybridStabilizer::HybridStabilizer(const HybridStabilizerConfig &config)
@@ -158,6 +182,15 @@ namespace GuitarDSP
         initialized = false;
     }
 
+    float HybridStabilizer::GetGroupDelay() const
+    {
+        // Median stage plus EMA stage at full confidence (fastest adaptive alpha)
+        const float alpha = ComputeAdaptiveAlpha(1.0f);
+        const float emaDelay = alpha > 0.0f ? (1.0f - alpha) / alpha : 0.0f;
+
+        return medianFilter.GetGroupDelay() + emaDelay;
+    }
+
     float HybridStabilizer::ComputeAdaptiveAlpha(float confidence) const
     {
         // High confidence → higher alpha → faster response
@@ -0,0 +1,365 @@
+#include "PitchToMidi.h"
+#include "KernelDispatch.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        constexpr float SLOW_ENERGY_SECONDS = 0.05f; ///< Time constant of the slow energy average
+        constexpr int32_t BEND_CENTRE = 8192;        ///< Pitch bend units per bend range
+        constexpr int32_t MAX_MIDI_NOTE = 127;       ///< Highest MIDI note number
+        constexpr float A4_MIDI = 69.0f;             ///< MIDI note number of A4
+
+        /**
+         * @brief Rounds value up to a multiple of step
+         */
+        size_t RoundUp(size_t value, size_t step)
+        {
+            return (value + step - 1) / step * step;
+        }
+
+        /**
+         * @brief Rounds windows and hops to whole blocks so estimates run exactly when due
+         */
+        PitchToMidiConfig Normalized(PitchToMidiConfig config)
+        {
+            config.blockSize = std::max<size_t>(config.blockSize, 1);
+            config.maxWindow = RoundUp(std::max<size_t>(config.maxWindow, 4), config.blockSize);
+            config.minWindow = std::min(RoundUp(config.minWindow, config.blockSize), config.maxWindow);
+            config.hopSize = RoundUp(std::max(config.hopSize, config.blockSize), config.blockSize);
+            return config;
+        }
+
+        /**
+         * @brief Builds progressive detector configuration
+         */
+        ProgressivePitchDetectorConfig ProgressiveConfig(const PitchToMidiConfig &config)
+        {
+            ProgressivePitchDetectorConfig progressiveConfig;
+            progressiveConfig.threshold = config.threshold;
+            progressiveConfig.minFrequency = config.minFrequency;
+            progressiveConfig.maxFrequency = config.maxFrequency;
+            progressiveConfig.maxBufferSize = config.maxWindow;
+            return progressiveConfig;
+        }
+
+        /**
+         * @brief Builds hop tracker configuration; its longest lag must stay below half the window
+         */
+        YinPitchDetectorConfig TrackerConfig(const PitchToMidiConfig &config)
+        {
+            YinPitchDetectorConfig trackerConfig;
+            trackerConfig.threshold = config.threshold;
+            trackerConfig.minFrequency =
+                std::max(config.minFrequency, config.sampleRate / static_cast<float>(config.maxWindow / 2 - 1));
+            trackerConfig.maxFrequency = config.maxFrequency;
+            trackerConfig.maxBufferSize = config.maxWindow;
+            trackerConfig.lazyEvaluation = true;
+            return trackerConfig;
+        }
+
+        /**
+         * @brief Converts dBFS to block mean square
+         */
+        float DbToEnergy(float db)
+        {
+            return std::pow(10.0f, db / 10.0f);
+        }
+    } // namespace
+
+    MidiEventQueue::MidiEventQueue(size_t capacity)
+        : events(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(events.size() - 1), writeIndex(0), readIndex(0),
+          droppedCount(0)
+    {
+    }
+
+    bool MidiEventQueue::Push(const MidiEvent &event)
+    {
+        const size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) > mask)
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        events[write & mask] = event;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool MidiEventQueue::Pop(MidiEvent &event)
+    {
+        const size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        event = events[read & mask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t MidiEventQueue::Drain(std::span<MidiEvent> output)
+    {
+        size_t count = 0;
+        while (count < output.size() && Pop(output[count]))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    uint64_t MidiEventQueue::GetDroppedCount() const
+    {
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    PitchToMidi::PitchToMidi(const PitchToMidiConfig &config)
+        : config(Normalized(config)), progressive(ProgressiveConfig(this->config)),
+          tracker(TrackerConfig(this->config)), events(config.queueCapacity), history({}), writeIndex(0), position(0),
+          blockFill(0), blockEnergy(0.0f), slowEnergy(0.0f), onsetEnergy(0.0f), releaseEnergy(0.0f),
+          state(State::Idle), onsetPosition(0), nextEstimate(0), peakEnergy(0.0f), activeNote(-1), candidateNote(-1),
+          candidateCount(0), lastBend(0), latency({})
+    {
+        history.resize(2 * this->config.maxWindow, 0.0f);
+        onsetEnergy = DbToEnergy(config.onsetGateDb);
+        releaseEnergy = DbToEnergy(config.releaseGateDb);
+    }
+
+    void PitchToMidi::Process(std::span<const float> input)
+    {
+        const size_t blockSize = config.blockSize;
+        const size_t maxWindow = config.maxWindow;
+        const KernelTable &kernels = GetKernels();
+
+        size_t offset = 0;
+        while (offset < input.size())
+        {
+            const size_t count = std::min(input.size() - offset, blockSize - blockFill);
+            const float *chunk = input.data() + offset;
+
+            // Mirrored ring: the newest maxWindow samples are always contiguous
+            for (size_t i = 0; i < count; ++i)
+            {
+                history[writeIndex] = chunk[i];
+                history[writeIndex + maxWindow] = chunk[i];
+                writeIndex = writeIndex + 1 == maxWindow ? 0 : writeIndex + 1;
+            }
+
+            blockEnergy += static_cast<float>(kernels.sumOfSquares(chunk, count));
+            blockFill += count;
+            position += count;
+            offset += count;
+
+            if (blockFill < blockSize)
+            {
+                continue;
+            }
+
+            EndBlock(blockEnergy);
+            blockFill = 0;
+            blockEnergy = 0.0f;
+
+            if (state != State::Idle)
+            {
+                Estimate();
+            }
+        }
+    }
+
+    MidiEventQueue &PitchToMidi::GetEvents()
+    {
+        return events;
+    }
+
+    MidiLatencyStatistics PitchToMidi::GetLatencyStatistics() const
+    {
+        return latency;
+    }
+
+    int32_t PitchToMidi::GetActiveNote() const
+    {
+        return activeNote;
+    }
+
+    void PitchToMidi::Reset()
+    {
+        ReleaseNote();
+
+        std::fill(history.begin(), history.end(), 0.0f);
+        writeIndex = 0;
+        position = 0;
+        blockFill = 0;
+        blockEnergy = 0.0f;
+        slowEnergy = 0.0f;
+        state = State::Idle;
+        onsetPosition = 0;
+        nextEstimate = 0;
+        peakEnergy = 0.0f;
+        candidateNote = -1;
+        candidateCount = 0;
+        lastBend = 0;
+        latency = MidiLatencyStatistics{};
+
+        progressive.Reset();
+        tracker.Reset();
+    }
+
+    void PitchToMidi::EndBlock(float energy)
+    {
+        const size_t blockSize = config.blockSize;
+        const float meanSquare = energy / static_cast<float>(blockSize);
+        const bool refractory = state != State::Idle && position - onsetPosition < config.minWindow + blockSize;
+        const bool onset = !refractory && meanSquare >= onsetEnergy && meanSquare > config.onsetRatio * slowEnergy;
+
+        if (onset)
+        {
+            ReleaseNote();
+            state = State::Pending;
+            onsetPosition = position - blockSize;
+            progressive.Reset();
+            peakEnergy = meanSquare;
+            candidateNote = -1;
+            candidateCount = 0;
+
+            // Restart the average at the attack level so the rest of the attack does not retrigger
+            slowEnergy = meanSquare;
+            return;
+        }
+
+        const float slowCoefficient =
+            std::min(1.0f, static_cast<float>(blockSize) / (SLOW_ENERGY_SECONDS * config.sampleRate));
+        slowEnergy += slowCoefficient * (meanSquare - slowEnergy);
+
+        if (state == State::Idle)
+        {
+            return;
+        }
+
+        peakEnergy = std::max(peakEnergy, meanSquare);
+        const float dropEnergy = peakEnergy * DbToEnergy(-config.releaseDropDb);
+        if (meanSquare < std::max(releaseEnergy, dropEnergy))
+        {
+            ReleaseNote();
+            state = State::Idle;
+        }
+    }
+
+    void PitchToMidi::Estimate()
+    {
+        const size_t blockSize = config.blockSize;
+        const size_t maxWindow = config.maxWindow;
+        std::optional<PitchResult> result;
+
+        if (!progressive.IsComplete())
+        {
+            // Grow the onset-anchored window by the block just completed
+            progressive.Push(std::span<const float>(history.data() + writeIndex + maxWindow - blockSize, blockSize));
+            if (position - onsetPosition < config.minWindow)
+            {
+                return;
+            }
+
+            result = progressive.Refine(config.sampleRate);
+            nextEstimate = position + config.hopSize;
+        }
+        else if (position >= nextEstimate)
+        {
+            result = tracker.Detect(std::span<const float>(history.data() + writeIndex, maxWindow), config.sampleRate);
+            nextEstimate += config.hopSize;
+        }
+
+        if (!result || result->frequency < config.minFrequency || result->frequency > config.maxFrequency)
+        {
+            return;
+        }
+
+        ApplyEstimate(A4_MIDI + 12.0f * std::log2(result->frequency / config.a4Frequency));
+    }
+
+    void PitchToMidi::ApplyEstimate(float midiNote)
+    {
+        const int32_t nearest = std::clamp(static_cast<int32_t>(std::lround(midiNote)), 0, MAX_MIDI_NOTE);
+
+        if (state == State::Pending)
+        {
+            StartNote(nearest, midiNote);
+            state = State::Sounding;
+
+            const auto samples = static_cast<uint32_t>(position - onsetPosition);
+            const auto budget = static_cast<uint32_t>(config.latencyBudgetMs * 0.001f * config.sampleRate);
+            ++latency.noteCount;
+            latency.lastSamples = samples;
+            latency.maxSamples = std::max(latency.maxSamples, samples);
+            latency.meanSamples += (samples - latency.meanSamples) / static_cast<double>(latency.noteCount);
+            latency.overBudget += samples > budget ? 1 : 0;
+            return;
+        }
+
+        // Note-locked: small deviations only bend, larger ones must persist to change the note
+        const float deviationCents = (midiNote - static_cast<float>(activeNote)) * 100.0f;
+        if (std::abs(deviationCents) <= config.hysteresisCents)
+        {
+            candidateCount = 0;
+            UpdateBend(midiNote, false);
+            return;
+        }
+
+        candidateCount = nearest == candidateNote ? candidateCount + 1 : 1;
+        candidateNote = nearest;
+        if (candidateCount >= config.noteChangeEstimates)
+        {
+            ReleaseNote();
+            StartNote(nearest, midiNote);
+        }
+    }
+
+    void PitchToMidi::ReleaseNote()
+    {
+        if (activeNote >= 0)
+        {
+            Emit(MidiEventType::NoteOff, static_cast<uint8_t>(activeNote), 0, 0);
+            activeNote = -1;
+        }
+    }
+
+    void PitchToMidi::StartNote(int32_t note, float midiNote)
+    {
+        // Velocity spans the onset gate up to full scale
+        const float levelDb = 10.0f * std::log10(std::max(peakEnergy, 1e-12f));
+        const float loudness = std::clamp((levelDb - config.onsetGateDb) / -config.onsetGateDb, 0.0f, 1.0f);
+        const auto velocity = static_cast<uint8_t>(1.0f + std::round(loudness * 126.0f));
+
+        activeNote = note;
+        candidateNote = -1;
+        candidateCount = 0;
+
+        // Bend first: synths apply it channel-wide to the note that follows
+        UpdateBend(midiNote, true);
+        Emit(MidiEventType::NoteOn, static_cast<uint8_t>(note), velocity, 0);
+    }
+
+    void PitchToMidi::UpdateBend(float midiNote, bool force)
+    {
+        const float semitones = midiNote - static_cast<float>(activeNote);
+        const auto scaled = static_cast<int32_t>(std::lround(semitones / config.pitchBendRange * BEND_CENTRE));
+        const int32_t bend = std::clamp(scaled, -BEND_CENTRE, BEND_CENTRE - 1);
+
+        if (force || std::abs(bend - lastBend) >= config.pitchBendStep)
+        {
+            Emit(MidiEventType::PitchBend, static_cast<uint8_t>(activeNote), 0, static_cast<int16_t>(bend));
+            lastBend = bend;
+        }
+    }
+
+    void PitchToMidi::Emit(MidiEventType type, uint8_t note, uint8_t velocity, int16_t bend)
+    {
+        const auto elapsed = static_cast<uint32_t>(position - onsetPosition);
+        events.Push(MidiEvent{ position, elapsed, type, config.channel, note, velocity, bend });
+    }
+
+} // namespace GuitarDSP
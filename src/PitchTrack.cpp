@@ -0,0 +1,487 @@
+#include "PitchTrack.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        // File and index magic
+        constexpr std::array<char, 4> TRACK_MAGIC = { 'G', 'P', 'T', 'K' };
+        constexpr std::array<char, 4> INDEX_MAGIC = { 'G', 'P', 'T', 'I' };
+
+        // Format version
+        constexpr uint16_t TRACK_VERSION = 1;
+
+        // Fixed record sizes (bytes)
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t CHUNK_HEADER_SIZE = 16;
+        constexpr size_t INDEX_RECORD_SIZE = 28;
+        constexpr size_t TRAILER_SIZE = 12;
+
+        // Worst case encoded entry: 10-byte varint delta + 5-byte zigzag varint + confidence
+        constexpr size_t MAX_ENTRY_SIZE = 16;
+
+        // Pitch reference for quantized cents
+        constexpr float REFERENCE_FREQUENCY = 440.0f;
+
+        // Finest quantization step: keeps the cents of any finite frequency (about ±180000) within int32
+        constexpr float MIN_CENTS_RESOLUTION = 1e-3f;
+
+        void PutU16(uint8_t *dst, uint16_t value)
+        {
+            dst[0] = static_cast<uint8_t>(value);
+            dst[1] = static_cast<uint8_t>(value >> 8);
+        }
+
+        void PutU32(uint8_t *dst, uint32_t value)
+        {
+            for (size_t i = 0; i < 4; ++i)
+            {
+                dst[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        void PutU64(uint8_t *dst, uint64_t value)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                dst[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        void PutF32(uint8_t *dst, float value)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            PutU32(dst, bits);
+        }
+
+        uint16_t GetU16(const uint8_t *src)
+        {
+            return static_cast<uint16_t>(src[0] | (src[1] << 8));
+        }
+
+        uint32_t GetU32(const uint8_t *src)
+        {
+            uint32_t value = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                value |= static_cast<uint32_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        uint64_t GetU64(const uint8_t *src)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                value |= static_cast<uint64_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        float GetF32(const uint8_t *src)
+        {
+            const uint32_t bits = GetU32(src);
+            float value = 0.0f;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        size_t PutVarint(uint8_t *dst, uint64_t value)
+        {
+            size_t size = 0;
+            while (value >= 0x80)
+            {
+                dst[size++] = static_cast<uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            dst[size++] = static_cast<uint8_t>(value);
+            return size;
+        }
+
+        bool GetVarint(const uint8_t *src, size_t size, size_t &position, uint64_t &value)
+        {
+            value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7)
+            {
+                if (position >= size)
+                {
+                    return false;
+                }
+
+                const uint8_t byte = src[position++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        uint64_t ZigZagEncode(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        int64_t ZigZagDecode(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+    } // namespace
+
+    PitchTrackWriter::PitchTrackWriter(std::ostream &stream, const PitchTrackConfig &config)
+        : stream(stream), config(config), chunkBuffer({}), chunkBytes(0), chunkEntries(0), chunkFirstTimestamp(0),
+          previousTimestamp(0), previousCents(0), bytesWritten(0), index({}), finished(false)
+    {
+        this->config.entriesPerChunk = std::max<uint32_t>(config.entriesPerChunk, 1);
+        if (!std::isfinite(this->config.centsResolution) || this->config.centsResolution <= 0.0f)
+        {
+            this->config.centsResolution = 0.1f;
+        }
+        this->config.centsResolution = std::max(this->config.centsResolution, MIN_CENTS_RESOLUTION);
+
+        // Pre-allocate chunk payload and index (real-time safe appends)
+        chunkBuffer.resize(static_cast<size_t>(this->config.entriesPerChunk) * MAX_ENTRY_SIZE);
+        index.reserve(config.expectedChunks);
+
+        std::array<uint8_t, HEADER_SIZE> header{};
+        std::memcpy(header.data(), TRACK_MAGIC.data(), TRACK_MAGIC.size());
+        PutU16(header.data() + 4, TRACK_VERSION);
+        PutU16(header.data() + 6, 0);
+        PutF32(header.data() + 8, this->config.timeBase);
+        PutF32(header.data() + 12, this->config.centsResolution);
+
+        stream.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+        bytesWritten += header.size();
+    }
+
+    PitchTrackWriter::~PitchTrackWriter()
+    {
+        if (!finished)
+        {
+            Finish();
+        }
+    }
+
+    bool PitchTrackWriter::Append(uint64_t timestamp, const PitchResult &result)
+    {
+        const bool firstEntry = index.empty() && chunkEntries == 0;
+        if (finished || !std::isfinite(result.frequency) || result.frequency <= 0.0f
+            || (!firstEntry && timestamp < previousTimestamp))
+        {
+            return false;
+        }
+
+        if (chunkEntries == 0)
+        {
+            // Each chunk restarts delta coding
+            chunkFirstTimestamp = timestamp;
+            previousTimestamp = timestamp;
+            previousCents = 0;
+        }
+
+        const float cents = 1200.0f * std::log2(result.frequency / REFERENCE_FREQUENCY);
+        const auto quantizedCents = static_cast<int32_t>(std::lround(cents / config.centsResolution));
+        const float clampedConfidence =
+            std::isnan(result.confidence) ? 0.0f : std::clamp(result.confidence, 0.0f, 1.0f);
+        const auto confidence = static_cast<uint8_t>(std::lround(clampedConfidence * 255.0f));
+
+        uint8_t *dst = chunkBuffer.data() + chunkBytes;
+        size_t size = PutVarint(dst, timestamp - previousTimestamp);
+        size += PutVarint(dst + size, ZigZagEncode(static_cast<int64_t>(quantizedCents) - previousCents));
+        dst[size++] = confidence;
+
+        chunkBytes += size;
+        previousTimestamp = timestamp;
+        previousCents = quantizedCents;
+        ++chunkEntries;
+
+        if (chunkEntries == config.entriesPerChunk)
+        {
+            return FlushChunk();
+        }
+
+        return true;
+    }
+
+    bool PitchTrackWriter::Finish()
+    {
+        if (finished)
+        {
+            return static_cast<bool>(stream);
+        }
+
+        FlushChunk();
+        finished = true;
+
+        const uint64_t indexOffset = bytesWritten;
+
+        std::array<uint8_t, INDEX_RECORD_SIZE> record{};
+        PutU32(record.data(), static_cast<uint32_t>(index.size()));
+        stream.write(reinterpret_cast<const char *>(record.data()), 4);
+
+        for (const auto &chunk : index)
+        {
+            PutU64(record.data(), chunk.offset);
+            PutU64(record.data() + 8, chunk.firstTimestamp);
+            PutU64(record.data() + 16, chunk.lastTimestamp);
+            PutU32(record.data() + 24, chunk.entryCount);
+            stream.write(reinterpret_cast<const char *>(record.data()), static_cast<std::streamsize>(record.size()));
+        }
+
+        std::array<uint8_t, TRAILER_SIZE> trailer{};
+        PutU64(trailer.data(), indexOffset);
+        std::memcpy(trailer.data() + 8, INDEX_MAGIC.data(), INDEX_MAGIC.size());
+        stream.write(reinterpret_cast<const char *>(trailer.data()), static_cast<std::streamsize>(trailer.size()));
+        stream.flush();
+
+        return static_cast<bool>(stream);
+    }
+
+    bool PitchTrackWriter::FlushChunk()
+    {
+        if (chunkEntries == 0)
+        {
+            return static_cast<bool>(stream);
+        }
+
+        std::array<uint8_t, CHUNK_HEADER_SIZE> header{};
+        PutU32(header.data(), chunkEntries);
+        PutU32(header.data() + 4, static_cast<uint32_t>(chunkBytes));
+        PutU64(header.data() + 8, chunkFirstTimestamp);
+
+        stream.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+        stream.write(reinterpret_cast<const char *>(chunkBuffer.data()), static_cast<std::streamsize>(chunkBytes));
+
+        index.push_back(PitchTrackChunkIndex{ bytesWritten, chunkFirstTimestamp, previousTimestamp, chunkEntries });
+        bytesWritten += header.size() + chunkBytes;
+
+        chunkBytes = 0;
+        chunkEntries = 0;
+
+        return static_cast<bool>(stream);
+    }
+
+    PitchTrackReader::PitchTrackReader(std::istream &stream)
+        : stream(stream), origin(0), timeBase(0.0f), centsResolution(0.0f), index({}), cachedEntries({}),
+          payload({}), cachedChunk(0), valid(false)
+    {
+        origin = stream.tellg();
+        if (origin < 0)
+        {
+            return;
+        }
+
+        std::array<uint8_t, HEADER_SIZE> header{};
+        if (!stream.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size()))
+            || std::memcmp(header.data(), TRACK_MAGIC.data(), TRACK_MAGIC.size()) != 0
+            || GetU16(header.data() + 4) != TRACK_VERSION)
+        {
+            return;
+        }
+
+        timeBase = GetF32(header.data() + 8);
+        centsResolution = GetF32(header.data() + 12);
+        if (!std::isfinite(centsResolution) || centsResolution < MIN_CENTS_RESOLUTION)
+        {
+            return; // Not written by PitchTrackWriter
+        }
+
+        // Locate index through trailer at end of stream
+        stream.seekg(0, std::ios::end);
+        const std::streamoff size = stream.tellg() - origin;
+        if (size < static_cast<std::streamoff>(HEADER_SIZE + 4 + TRAILER_SIZE))
+        {
+            return;
+        }
+
+        std::array<uint8_t, TRAILER_SIZE> trailer{};
+        stream.seekg(origin + size - static_cast<std::streamoff>(TRAILER_SIZE));
+        if (!stream.read(reinterpret_cast<char *>(trailer.data()), static_cast<std::streamsize>(trailer.size()))
+            || std::memcmp(trailer.data() + 8, INDEX_MAGIC.data(), INDEX_MAGIC.size()) != 0)
+        {
+            return;
+        }
+
+        const uint64_t indexOffset = GetU64(trailer.data());
+        if (indexOffset + 4 + TRAILER_SIZE > static_cast<uint64_t>(size))
+        {
+            return;
+        }
+
+        std::array<uint8_t, INDEX_RECORD_SIZE> record{};
+        stream.seekg(origin + static_cast<std::streamoff>(indexOffset));
+        if (!stream.read(reinterpret_cast<char *>(record.data()), 4))
+        {
+            return;
+        }
+
+        const uint32_t chunkCount = GetU32(record.data());
+        if (indexOffset + 4 + static_cast<uint64_t>(chunkCount) * INDEX_RECORD_SIZE + TRAILER_SIZE
+            != static_cast<uint64_t>(size))
+        {
+            return;
+        }
+
+        index.reserve(chunkCount);
+        for (uint32_t i = 0; i < chunkCount; ++i)
+        {
+            if (!stream.read(reinterpret_cast<char *>(record.data()), static_cast<std::streamsize>(record.size())))
+            {
+                index.clear();
+                return;
+            }
+
+            const uint8_t *fields = record.data();
+            index.push_back(
+                PitchTrackChunkIndex{ GetU64(fields), GetU64(fields + 8), GetU64(fields + 16), GetU32(fields + 24) });
+        }
+
+        cachedChunk = index.size();
+        valid = true;
+    }
+
+    bool PitchTrackReader::IsValid() const
+    {
+        return valid;
+    }
+
+    float PitchTrackReader::GetTimeBase() const
+    {
+        return timeBase;
+    }
+
+    uint64_t PitchTrackReader::GetEntryCount() const
+    {
+        uint64_t count = 0;
+        for (const auto &chunk : index)
+        {
+            count += chunk.entryCount;
+        }
+        return count;
+    }
+
+    std::optional<PitchTrackEntry> PitchTrackReader::FindAt(uint64_t timestamp)
+    {
+        if (!valid || index.empty() || timestamp < index.front().firstTimestamp)
+        {
+            return std::nullopt;
+        }
+
+        // Last chunk starting at or before timestamp
+        auto chunkIt = std::upper_bound(index.begin(),
+            index.end(),
+            timestamp,
+            [](uint64_t value, const PitchTrackChunkIndex &chunk) { return value < chunk.firstTimestamp; });
+        const auto chunk = static_cast<size_t>(std::distance(index.begin(), chunkIt)) - 1;
+
+        if (!LoadChunk(chunk))
+        {
+            return std::nullopt;
+        }
+
+        auto entryIt = std::upper_bound(cachedEntries.begin(),
+            cachedEntries.end(),
+            timestamp,
+            [](uint64_t value, const PitchTrackEntry &entry) { return value < entry.timestamp; });
+
+        return *(entryIt - 1);
+    }
+
+    bool PitchTrackReader::ReadRange(uint64_t begin, uint64_t end, std::vector<PitchTrackEntry> &entries)
+    {
+        if (!valid)
+        {
+            return false;
+        }
+
+        for (size_t chunk = 0; chunk < index.size(); ++chunk)
+        {
+            if (index[chunk].lastTimestamp < begin || index[chunk].firstTimestamp >= end)
+            {
+                continue;
+            }
+
+            if (!LoadChunk(chunk))
+            {
+                return false;
+            }
+
+            for (const auto &entry : cachedEntries)
+            {
+                if (entry.timestamp >= begin && entry.timestamp < end)
+                {
+                    entries.push_back(entry);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool PitchTrackReader::LoadChunk(size_t chunk)
+    {
+        if (chunk == cachedChunk)
+        {
+            return true;
+        }
+
+        std::array<uint8_t, CHUNK_HEADER_SIZE> header{};
+        stream.clear();
+        stream.seekg(origin + static_cast<std::streamoff>(index[chunk].offset));
+        if (!stream.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size())))
+        {
+            return false;
+        }
+
+        const uint32_t entryCount = GetU32(header.data());
+        const uint32_t payloadSize = GetU32(header.data() + 4);
+        uint64_t timestamp = GetU64(header.data() + 8);
+
+        if (entryCount != index[chunk].entryCount || payloadSize > entryCount * MAX_ENTRY_SIZE)
+        {
+            return false;
+        }
+
+        payload.resize(payloadSize);
+        if (!stream.read(reinterpret_cast<char *>(payload.data()), static_cast<std::streamsize>(payloadSize)))
+        {
+            return false;
+        }
+
+        cachedChunk = index.size();
+        cachedEntries.clear();
+        cachedEntries.reserve(entryCount);
+
+        size_t position = 0;
+        int64_t cents = 0;
+        for (uint32_t i = 0; i < entryCount; ++i)
+        {
+            uint64_t timeDelta = 0;
+            uint64_t centsDelta = 0;
+            if (!GetVarint(payload.data(), payload.size(), position, timeDelta)
+                || !GetVarint(payload.data(), payload.size(), position, centsDelta) || position >= payload.size())
+            {
+                return false;
+            }
+
+            timestamp += timeDelta;
+            cents += ZigZagDecode(centsDelta);
+            const float confidence = static_cast<float>(payload[position++]) / 255.0f;
+            const float frequency =
+                REFERENCE_FREQUENCY * std::exp2(static_cast<float>(cents) * centsResolution / 1200.0f);
+
+            cachedEntries.push_back(PitchTrackEntry{ timestamp, PitchResult{ frequency, confidence } });
+        }
+
+        cachedChunk = chunk;
+        return true;
+    }
+
+} // namespace GuitarDSP
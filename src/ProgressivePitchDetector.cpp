@@ -0,0 +1,154 @@
+#include "ProgressivePitchDetector.h"
+#include "KernelDispatch.h"
+#include "StageProfiler.h"
+#include <algorithm>
+
+namespace GuitarDSP
+{
+    ProgressivePitchDetector::ProgressivePitchDetector(const ProgressivePitchDetectorConfig &config)
+        : config(config), window({}), differences({}), yinBuffer({}), windowSize(0), halfSize(0)
+    {
+        // Pre-allocate window and per-lag state (real-time safe)
+        window.resize(config.maxBufferSize, 0.0f);
+        differences.resize(config.maxBufferSize / 2, 0.0);
+        yinBuffer.resize(config.maxBufferSize / 2, 0.0f);
+    }
+
+    ProgressivePitchDetector::~ProgressivePitchDetector() = default;
+
+    std::optional<PitchResult> ProgressivePitchDetector::Detect(std::span<const float> buffer, float sampleRate)
+    {
+        Reset();
+        Push(buffer);
+        return Refine(sampleRate);
+    }
+
+    void ProgressivePitchDetector::Reset()
+    {
+        windowSize = 0;
+        halfSize = 0;
+    }
+
+    size_t ProgressivePitchDetector::Push(std::span<const float> input)
+    {
+        const size_t count = std::min(input.size(), window.size() - windowSize);
+        std::copy_n(input.begin(), count, window.begin() + static_cast<std::ptrdiff_t>(windowSize));
+        windowSize += count;
+        return count;
+    }
+
+    std::optional<PitchResult> ProgressivePitchDetector::Refine(float sampleRate)
+    {
+        if (sampleRate <= 0.0f)
+        {
+            return std::nullopt;
+        }
+
+        if (windowSize / 2 > halfSize)
+        {
+            Extend(windowSize / 2);
+        }
+
+        // Lags beyond the current window are searched once it has grown far enough
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinThreshold);
+        const auto minTau = std::max<size_t>(static_cast<size_t>(sampleRate / config.maxFrequency), 1);
+        const auto maxTau = std::min(static_cast<size_t>(sampleRate / config.minFrequency), halfSize - 1);
+        if (halfSize < 3 || minTau >= maxTau)
+        {
+            return std::nullopt;
+        }
+
+        yinBuffer[0] = 1.0f;
+        double runningSum = 0.0;
+
+        // Cumulative mean normalisation for a single lag; the running sum only needs lags up to tau
+        auto normalize = [&](size_t tau) {
+            runningSum += differences[tau];
+            yinBuffer[tau] =
+                runningSum != 0.0 ? static_cast<float>(differences[tau] * static_cast<double>(tau) / runningSum) : 1.0f;
+        };
+
+        for (size_t tau = 1; tau < maxTau; ++tau)
+        {
+            normalize(tau);
+            if (tau < minTau || yinBuffer[tau] >= config.threshold)
+            {
+                continue;
+            }
+
+            // Follow the dip to its minimum; the first larger lag is kept for interpolation
+            while (tau + 1 < halfSize)
+            {
+                normalize(tau + 1);
+                if (yinBuffer[tau + 1] >= yinBuffer[tau])
+                {
+                    break;
+                }
+                ++tau;
+            }
+
+            // Still falling at the window edge: wait for more samples
+            if (tau + 1 >= halfSize)
+            {
+                return std::nullopt;
+            }
+
+            return MakeResult(tau, sampleRate);
+        }
+
+        return std::nullopt;
+    }
+
+    size_t ProgressivePitchDetector::GetWindowSize() const
+    {
+        return windowSize;
+    }
+
+    bool ProgressivePitchDetector::IsComplete() const
+    {
+        return windowSize == window.size();
+    }
+
+    void ProgressivePitchDetector::Extend(size_t newHalfSize)
+    {
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinDifference);
+        const KernelTable &kernels = GetKernels();
+        const float *data = window.data();
+
+        // Existing lags: add only the terms j in [halfSize, newHalfSize)
+        const size_t grown = newHalfSize - halfSize;
+        for (size_t tau = 0; tau < halfSize; ++tau)
+        {
+            differences[tau] += kernels.squaredDifferenceSum(data + halfSize, data + halfSize + tau, grown);
+        }
+
+        // New lags: full sum over the grown span
+        for (size_t tau = halfSize; tau < newHalfSize; ++tau)
+        {
+            differences[tau] = kernels.squaredDifferenceSum(data, data + tau, newHalfSize);
+        }
+
+        halfSize = newHalfSize;
+    }
+
+    PitchResult ProgressivePitchDetector::MakeResult(size_t tau, float sampleRate) const
+    {
+        // Parabolic interpolation for sub-sample accuracy
+        float betterTau = static_cast<float>(tau);
+
+        const float s0 = yinBuffer[tau - 1];
+        const float s1 = yinBuffer[tau];
+        const float s2 = yinBuffer[tau + 1];
+        const float denominator = 2.0f * (2.0f * s1 - s2 - s0);
+        if (denominator != 0.0f)
+        {
+            betterTau += (s2 - s0) / denominator;
+        }
+
+        const float frequency = sampleRate / betterTau;
+        const float confidence = 1.0f - yinBuffer[tau];
+
+        return PitchResult{ frequency, confidence };
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,250 @@
+#include "ResonatorBank.h"
+#include "NoteConverter.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        constexpr double TWO_PI = 2.0 * std::numbers::pi; ///< Radians per cycle
+        constexpr size_t BINS_PER_PARTIAL = 3;            ///< Bins at w - 2pi/N, w, w + 2pi/N
+        constexpr double HANN_GAIN = 0.5;                 ///< Coherent gain of the Hann window
+
+        /**
+         * @brief Advances every bin by one sample
+         *
+         * The arrays never overlap; __restrict lets the compiler vectorize
+         * across bins without runtime alias checks for all eight arrays.
+         */
+        void AdvanceBins(const double *__restrict stepRe,
+            const double *__restrict stepIm,
+            const double *__restrict wrapRe,
+            const double *__restrict wrapIm,
+            double *__restrict phasorRe,
+            double *__restrict phasorIm,
+            double *__restrict sumRe,
+            double *__restrict sumIm,
+            size_t count,
+            double newest,
+            double oldest)
+        {
+            for (size_t k = 0; k < count; ++k)
+            {
+                // S += p * (x[n] - x[n-N] * exp(j w N)), then p *= exp(-j w)
+                const double inputRe = newest - oldest * wrapRe[k];
+                const double inputIm = -oldest * wrapIm[k];
+                const double pRe = phasorRe[k];
+                const double pIm = phasorIm[k];
+                sumRe[k] += pRe * inputRe - pIm * inputIm;
+                sumIm[k] += pRe * inputIm + pIm * inputRe;
+                phasorRe[k] = pRe * stepRe[k] - pIm * stepIm[k];
+                phasorIm[k] = pRe * stepIm[k] + pIm * stepRe[k];
+            }
+        }
+    } // namespace
+
+    ResonatorBank::ResonatorBank(const ResonatorBankConfig &config)
+        : config(config), readings({}), stepRe({}), stepIm({}), wrapRe({}), wrapIm({}), phasorRe({}), phasorIm({}),
+          sumRe({}), sumIm({}), lastAngle({}), history({}), historyIndex(0), sinceOffset(0), hasLastAngle(false)
+    {
+        this->config.windowSize = std::max<size_t>(config.windowSize, 1);
+        this->config.offsetInterval = std::max<size_t>(config.offsetInterval, 1);
+
+        const size_t partials = config.targets.size() * config.harmonicCount;
+        const size_t count = partials * BINS_PER_PARTIAL;
+        readings.reserve(partials);
+        stepRe.reserve(count);
+        stepIm.reserve(count);
+        wrapRe.reserve(count);
+        wrapIm.reserve(count);
+
+        const auto windowSize = static_cast<double>(this->config.windowSize);
+        const double binSpacing = TWO_PI / windowSize;
+        for (const ResonatorTarget &target : config.targets)
+        {
+            const float fundamental =
+                NoteConverter::NoteToFrequency(target.noteName, target.octave, config.a4Frequency);
+            for (size_t harmonic = 1; harmonic <= config.harmonicCount; ++harmonic)
+            {
+                const float frequency = fundamental * static_cast<float>(harmonic);
+                const double omega = TWO_PI * static_cast<double>(frequency) / static_cast<double>(config.sampleRate);
+                readings.push_back(ResonatorReading{ frequency, 0.0f, 0.0f, 0.0f, 0.0f });
+
+                for (const double binOmega : { omega - binSpacing, omega, omega + binSpacing })
+                {
+                    stepRe.push_back(std::cos(binOmega));
+                    stepIm.push_back(-std::sin(binOmega));
+                    wrapRe.push_back(std::cos(binOmega * windowSize));
+                    wrapIm.push_back(std::sin(binOmega * windowSize));
+                }
+            }
+        }
+
+        phasorRe.resize(count, 1.0);
+        phasorIm.resize(count, 0.0);
+        sumRe.resize(count, 0.0);
+        sumIm.resize(count, 0.0);
+        lastAngle.resize(partials, 0.0);
+        history.resize(this->config.windowSize, 0.0f);
+    }
+
+    void ResonatorBank::Process(std::span<const float> input)
+    {
+        const size_t count = sumRe.size();
+
+        for (const float sample : input)
+        {
+            // Sample leaving the window is replaced by the new one in the shared history
+            const double newest = sample;
+            const double oldest = history[historyIndex];
+            history[historyIndex] = sample;
+            historyIndex = historyIndex + 1 == history.size() ? 0 : historyIndex + 1;
+
+            AdvanceBins(stepRe.data(),
+                stepIm.data(),
+                wrapRe.data(),
+                wrapIm.data(),
+                phasorRe.data(),
+                phasorIm.data(),
+                sumRe.data(),
+                sumIm.data(),
+                count,
+                newest,
+                oldest);
+
+            if (++sinceOffset == config.offsetInterval)
+            {
+                MeasureOffsets();
+                NormalizePhasors();
+                sinceOffset = 0;
+            }
+        }
+
+        NormalizePhasors();
+        UpdateReadings();
+    }
+
+    std::span<const ResonatorReading> ResonatorBank::GetReadings() const
+    {
+        return readings;
+    }
+
+    const ResonatorReading &ResonatorBank::GetReading(size_t target, size_t harmonic) const
+    {
+        return readings[target * config.harmonicCount + harmonic];
+    }
+
+    size_t ResonatorBank::GetTargetCount() const
+    {
+        return config.targets.size();
+    }
+
+    size_t ResonatorBank::GetStrongestTarget() const
+    {
+        size_t strongest = config.targets.size();
+        float strongestMagnitude = 0.0f;
+
+        for (size_t target = 0; target < config.targets.size(); ++target)
+        {
+            float magnitude = 0.0f;
+            for (size_t harmonic = 0; harmonic < config.harmonicCount; ++harmonic)
+            {
+                magnitude += GetReading(target, harmonic).magnitude;
+            }
+
+            if (magnitude > strongestMagnitude)
+            {
+                strongest = target;
+                strongestMagnitude = magnitude;
+            }
+        }
+
+        return strongest;
+    }
+
+    void ResonatorBank::Reset()
+    {
+        std::fill(phasorRe.begin(), phasorRe.end(), 1.0);
+        std::fill(phasorIm.begin(), phasorIm.end(), 0.0);
+        std::fill(sumRe.begin(), sumRe.end(), 0.0);
+        std::fill(sumIm.begin(), sumIm.end(), 0.0);
+        std::fill(lastAngle.begin(), lastAngle.end(), 0.0);
+        std::fill(history.begin(), history.end(), 0.0f);
+        historyIndex = 0;
+        sinceOffset = 0;
+        hasLastAngle = false;
+
+        for (ResonatorReading &reading : readings)
+        {
+            reading = ResonatorReading{ reading.frequency, 0.0f, 0.0f, 0.0f, 0.0f };
+        }
+    }
+
+    std::complex<double> ResonatorBank::GetWindowedSum(size_t partial) const
+    {
+        const size_t lower = partial * BINS_PER_PARTIAL;
+        const size_t centre = lower + 1;
+        const size_t upper = lower + 2;
+        const std::complex<double> lowerSum(sumRe[lower], sumIm[lower]);
+        const std::complex<double> centreSum(sumRe[centre], sumIm[centre]);
+        const std::complex<double> upperSum(sumRe[upper], sumIm[upper]);
+
+        // Hann in the frequency domain; exp(-j 2pi (n+1) / N) aligns the side bins with the window start
+        const std::complex<double> alignment = std::complex<double>(phasorRe[upper], phasorIm[upper])
+                                               * std::conj(std::complex<double>(phasorRe[centre], phasorIm[centre]));
+        return 0.5 * centreSum - 0.25 * (alignment * lowerSum + std::conj(alignment) * upperSum);
+    }
+
+    void ResonatorBank::UpdateReadings()
+    {
+        const double scale = 2.0 / (HANN_GAIN * static_cast<double>(config.windowSize));
+
+        for (size_t k = 0; k < readings.size(); ++k)
+        {
+            // Phasors already point at the next sample; one step back refers the phase to the newest
+            const size_t centre = k * BINS_PER_PARTIAL + 1;
+            const std::complex<double> sum = GetWindowedSum(k);
+            const std::complex<double> phasor(phasorRe[centre], phasorIm[centre]);
+            const std::complex<double> step(stepRe[centre], stepIm[centre]);
+            const std::complex<double> current = sum * std::conj(phasor) * step;
+            readings[k].magnitude = static_cast<float>(scale * std::abs(sum));
+            readings[k].phase = static_cast<float>(std::arg(current));
+        }
+    }
+
+    void ResonatorBank::MeasureOffsets()
+    {
+        const double hertzPerRadian =
+            static_cast<double>(config.sampleRate) / (TWO_PI * static_cast<double>(config.offsetInterval));
+
+        for (size_t k = 0; k < readings.size(); ++k)
+        {
+            // The sum is demodulated at the partial's frequency: any rotation is its deviation
+            const double angle = std::arg(GetWindowedSum(k));
+            if (hasLastAngle)
+            {
+                const double offset = std::remainder(angle - lastAngle[k], TWO_PI) * hertzPerRadian;
+                const float frequency = readings[k].frequency;
+                readings[k].frequencyOffset = static_cast<float>(offset);
+                readings[k].cents = NoteConverter::FrequencyToCents(frequency + static_cast<float>(offset), frequency);
+            }
+            lastAngle[k] = angle;
+        }
+
+        hasLastAngle = true;
+    }
+
+    void ResonatorBank::NormalizePhasors()
+    {
+        for (size_t k = 0; k < phasorRe.size(); ++k)
+        {
+            const double length = std::hypot(phasorRe[k], phasorIm[k]);
+            phasorRe[k] /= length;
+            phasorIm[k] /= length;
+        }
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,190 @@
+#include "SpectralAnalysisHub.h"
+#include "KernelDispatch.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GuitarDSP
+{
+    SpectralAnalysisHub::SpectralAnalysisHub(const SpectralAnalysisHubConfig &config)
+        : config(config), fft(config.fftSize, config.sampleRate), history({}), window({}), frame({}),
+          magnitudes({}), consumers({}), writeIndex(0), samplesReceived(0), hopIndex(0), transformCount(0),
+          samplesUntilFrame(config.fftSize), hasFrame(false), spectrumValid(false), magnitudesValid(false)
+    {
+        this->config.hopSize = std::max<size_t>(config.hopSize, 1);
+
+        // Pre-allocate history, window and scratch (real-time safe)
+        history.resize(config.fftSize * 2, 0.0f);
+        frame.resize(config.fftSize, 0.0f);
+        magnitudes.resize(config.fftSize / 2, 0.0f);
+        consumers.reserve(config.maxConsumers);
+
+        // Periodic Hann window
+        window.resize(config.fftSize, 1.0f);
+        if (config.applyWindow)
+        {
+            const double step = 2.0 * std::numbers::pi / static_cast<double>(config.fftSize);
+            for (size_t i = 0; i < config.fftSize; ++i)
+            {
+                const double phase = step * static_cast<double>(i);
+                window[i] = static_cast<float>(0.5 - 0.5 * std::cos(phase));
+            }
+        }
+    }
+
+    bool SpectralAnalysisHub::AddConsumer(SpectrumConsumer *consumer)
+    {
+        if (consumer == nullptr || consumers.size() >= config.maxConsumers
+            || std::find(consumers.begin(), consumers.end(), consumer) != consumers.end())
+        {
+            return false;
+        }
+
+        consumers.push_back(consumer);
+        return true;
+    }
+
+    bool SpectralAnalysisHub::RemoveConsumer(SpectrumConsumer *consumer)
+    {
+        const auto it = std::find(consumers.begin(), consumers.end(), consumer);
+        if (it == consumers.end())
+        {
+            return false;
+        }
+
+        consumers.erase(it);
+        return true;
+    }
+
+    size_t SpectralAnalysisHub::Push(std::span<const float> samples)
+    {
+        const size_t fftSize = config.fftSize;
+        if (fftSize == 0)
+        {
+            return 0;
+        }
+
+        size_t completed = 0;
+        size_t offset = 0;
+
+        while (offset < samples.size())
+        {
+            // Copy up to the next frame boundary or ring wrap, into both mirror halves
+            const size_t chunk = std::min({ samples.size() - offset, samplesUntilFrame, fftSize - writeIndex });
+            const float *source = samples.data() + offset;
+            std::copy_n(source, chunk, history.begin() + static_cast<std::ptrdiff_t>(writeIndex));
+            std::copy_n(source, chunk, history.begin() + static_cast<std::ptrdiff_t>(writeIndex + fftSize));
+
+            writeIndex = (writeIndex + chunk) % fftSize;
+            samplesReceived += chunk;
+            samplesUntilFrame -= chunk;
+            offset += chunk;
+
+            if (samplesUntilFrame > 0)
+            {
+                continue;
+            }
+
+            hopIndex = hasFrame ? hopIndex + 1 : 0;
+            hasFrame = true;
+            samplesUntilFrame = config.hopSize;
+            ++completed;
+
+            // Snapshot the windowed frame now so a later lazy transform still sees this hop
+            const float *oldest = history.data() + writeIndex;
+            for (size_t i = 0; i < fftSize; ++i)
+            {
+                frame[i] = oldest[i] * window[i];
+            }
+            spectrumValid = false;
+            magnitudesValid = false;
+
+            if (!consumers.empty())
+            {
+                Dispatch();
+            }
+        }
+
+        return completed;
+    }
+
+    bool SpectralAnalysisHub::HasFrame() const
+    {
+        return hasFrame;
+    }
+
+    const FFTSpectrum &SpectralAnalysisHub::GetSpectrum()
+    {
+        EnsureSpectrum();
+        return fft.GetSpectrum();
+    }
+
+    std::span<const float> SpectralAnalysisHub::GetMagnitudes()
+    {
+        EnsureMagnitudes();
+        return magnitudes;
+    }
+
+    uint64_t SpectralAnalysisHub::GetHopIndex() const
+    {
+        return hopIndex;
+    }
+
+    uint64_t SpectralAnalysisHub::GetTransformCount() const
+    {
+        return transformCount;
+    }
+
+    void SpectralAnalysisHub::Reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        std::fill(magnitudes.begin(), magnitudes.end(), 0.0f);
+        writeIndex = 0;
+        samplesReceived = 0;
+        hopIndex = 0;
+        transformCount = 0;
+        samplesUntilFrame = config.fftSize;
+        hasFrame = false;
+        spectrumValid = false;
+        magnitudesValid = false;
+    }
+
+    void SpectralAnalysisHub::EnsureSpectrum()
+    {
+        if (spectrumValid)
+        {
+            return;
+        }
+
+        fft.ComputeSpectrum(frame);
+        spectrumValid = true;
+        ++transformCount;
+    }
+
+    void SpectralAnalysisHub::EnsureMagnitudes()
+    {
+        if (magnitudesValid)
+        {
+            return;
+        }
+
+        EnsureSpectrum();
+        const FFTSpectrum &spectrum = fft.GetSpectrum();
+        const size_t binCount = std::min(magnitudes.size(), spectrum.data.size() / 2);
+        GetKernels().complexMagnitude(spectrum.data.data(), magnitudes.data(), binCount);
+        magnitudesValid = true;
+    }
+
+    void SpectralAnalysisHub::Dispatch()
+    {
+        EnsureMagnitudes();
+
+        const SpectrumFrame shared{ fft.GetSpectrum(), magnitudes, hopIndex, samplesReceived - config.fftSize };
+        for (SpectrumConsumer *consumer : consumers)
+        {
+            consumer->OnSpectrum(shared);
+        }
+    }
+
+} // namespace GuitarDSP
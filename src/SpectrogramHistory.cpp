@@ -0,0 +1,219 @@
+#include "SpectrogramHistory.h"
+#include "KernelDispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        constexpr float LOWEST_LEVEL_DB = -240.0f; ///< Level stored for silent bins
+        constexpr float LOWEST_RATIO = 1e-12f;     ///< Magnitude ratio of LOWEST_LEVEL_DB
+
+        /**
+         * @brief Quantizes dB levels against a column scale
+         */
+        template<typename Cell>
+        void QuantizeColumn(std::span<const float> levelsDb, float minDb, float inverseStep, Cell *cells)
+        {
+            constexpr auto MAX_LEVEL = static_cast<float>(static_cast<Cell>(~Cell{ 0 }));
+            for (size_t row = 0; row < levelsDb.size(); ++row)
+            {
+                const float position = std::clamp((levelsDb[row] - minDb) * inverseStep, 0.0f, MAX_LEVEL);
+                cells[row] = static_cast<Cell>(position + 0.5f);
+            }
+        }
+    } // namespace
+
+    SpectrogramHistory::SpectrogramHistory(const SpectrogramHistoryConfig &config)
+        : config(config), rowCount(config.binCount), reducer(nullptr), bands(nullptr), levels({}), cells8({}),
+          cells16({}), scales({}), writeSlot(0), frameCount(0), totalFrames(0)
+    {
+        if (config.logFrequency)
+        {
+            SpectrumBandReducerConfig bandConfig;
+            bandConfig.fftSize = config.binCount * 2;
+            bandConfig.sampleRate = config.sampleRate;
+            bandConfig.bandCount = config.bandCount;
+            bandConfig.minFrequency = config.minFrequency;
+            bandConfig.maxFrequency = config.maxFrequency;
+            bandConfig.referenceMagnitude = config.referenceMagnitude;
+            bandConfig.floorDb = LOWEST_LEVEL_DB;
+
+            reducer = std::make_unique<SpectrumBandReducer>(bandConfig);
+            bands = std::make_unique<DisplayBands>();
+            rowCount = reducer->GetBandCount();
+        }
+
+        const size_t cellCount = config.capacity * rowCount;
+        if (config.precision == SpectrogramPrecision::Bits8)
+        {
+            cells8.resize(cellCount, 0);
+        }
+        else
+        {
+            cells16.resize(cellCount, 0);
+        }
+
+        levels.resize(rowCount, LOWEST_LEVEL_DB);
+        scales.resize(config.capacity, ColumnScale{ LOWEST_LEVEL_DB, 0.0f });
+    }
+
+    bool SpectrogramHistory::Append(std::span<const float> magnitudes)
+    {
+        if (magnitudes.size() < config.binCount || config.capacity == 0 || rowCount == 0)
+        {
+            return false;
+        }
+
+        if (reducer)
+        {
+            // Loudest bin per band: narrow partials stay visible on the log axis
+            reducer->Process(magnitudes.first(config.binCount), *bands);
+            std::copy_n(bands->peakDb.begin(), rowCount, levels.begin());
+        }
+        else
+        {
+            const float inverseReference = config.referenceMagnitude > 0.0f ? 1.0f / config.referenceMagnitude : 1.0f;
+            for (size_t row = 0; row < rowCount; ++row)
+            {
+                levels[row] = 20.0f * std::log10(std::max(magnitudes[row] * inverseReference, LOWEST_RATIO));
+            }
+        }
+
+        // Per-column scale: span the frame's own levels, but no more than dynamicRangeDb below its peak
+        const float maxDb = GetKernels().maximum(levels.data(), rowCount);
+        const float minDb = std::max(*std::min_element(levels.begin(), levels.end()), maxDb - config.dynamicRangeDb);
+        const float maxLevel = config.precision == SpectrogramPrecision::Bits8 ? 255.0f : 65535.0f;
+        const float stepDb = (maxDb - minDb) / maxLevel;
+        const float inverseStep = stepDb > 0.0f ? 1.0f / stepDb : 0.0f;
+
+        const size_t offset = writeSlot * rowCount;
+        if (config.precision == SpectrogramPrecision::Bits8)
+        {
+            QuantizeColumn<uint8_t>(levels, minDb, inverseStep, cells8.data() + offset);
+        }
+        else
+        {
+            QuantizeColumn<uint16_t>(levels, minDb, inverseStep, cells16.data() + offset);
+        }
+        scales[writeSlot] = ColumnScale{ minDb, stepDb };
+
+        writeSlot = (writeSlot + 1) % config.capacity;
+        frameCount = std::min(frameCount + 1, config.capacity);
+        ++totalFrames;
+        return true;
+    }
+
+    bool SpectrogramHistory::ReadColumn(size_t frame, std::span<float> levelsDb) const
+    {
+        if (frame >= frameCount)
+        {
+            return false;
+        }
+
+        const size_t slot = GetSlot(frame);
+        const size_t count = std::min(levelsDb.size(), rowCount);
+        for (size_t row = 0; row < count; ++row)
+        {
+            levelsDb[row] = ReadCell(slot, row);
+        }
+        return true;
+    }
+
+    size_t SpectrogramHistory::ReadRow(size_t row, size_t firstFrame, std::span<float> levelsDb) const
+    {
+        if (row >= rowCount || firstFrame >= frameCount)
+        {
+            return 0;
+        }
+
+        const size_t count = std::min(levelsDb.size(), frameCount - firstFrame);
+        for (size_t i = 0; i < count; ++i)
+        {
+            levelsDb[i] = ReadCell(GetSlot(firstFrame + i), row);
+        }
+        return count;
+    }
+
+    bool SpectrogramHistory::ReadRegion(size_t firstFrame,
+        size_t frames,
+        size_t firstRow,
+        size_t rows,
+        std::span<float> levelsDb) const
+    {
+        if (firstFrame + frames > frameCount || firstRow + rows > rowCount || levelsDb.size() < frames * rows)
+        {
+            return false;
+        }
+
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            const size_t slot = GetSlot(firstFrame + frame);
+            float *output = levelsDb.data() + frame * rows;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                output[row] = ReadCell(slot, firstRow + row);
+            }
+        }
+        return true;
+    }
+
+    size_t SpectrogramHistory::GetRowCount() const
+    {
+        return rowCount;
+    }
+
+    float SpectrogramHistory::GetRowFrequency(size_t row) const
+    {
+        if (row >= rowCount)
+        {
+            return 0.0f;
+        }
+        if (reducer)
+        {
+            return reducer->GetBandFrequency(row);
+        }
+        return static_cast<float>(row) * config.sampleRate / static_cast<float>(2 * config.binCount);
+    }
+
+    size_t SpectrogramHistory::GetFrameCount() const
+    {
+        return frameCount;
+    }
+
+    uint64_t SpectrogramHistory::GetTotalFrames() const
+    {
+        return totalFrames;
+    }
+
+    size_t SpectrogramHistory::GetMemoryUsage() const
+    {
+        return cells8.size() + cells16.size() * sizeof(uint16_t) + scales.size() * sizeof(ColumnScale);
+    }
+
+    void SpectrogramHistory::Reset()
+    {
+        writeSlot = 0;
+        frameCount = 0;
+        totalFrames = 0;
+        if (reducer)
+        {
+            reducer->Reset();
+        }
+    }
+
+    size_t SpectrogramHistory::GetSlot(size_t frame) const
+    {
+        const size_t oldest = (writeSlot + config.capacity - frameCount) % config.capacity;
+        return (oldest + frame) % config.capacity;
+    }
+
+    float SpectrogramHistory::ReadCell(size_t slot, size_t row) const
+    {
+        const size_t index = slot * rowCount + row;
+        const float level = cells8.empty() ? static_cast<float>(cells16[index]) : static_cast<float>(cells8[index]);
+        return scales[slot].minDb + level * scales[slot].stepDb;
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,129 @@
+#include "SpectrumBandReducer.h"
+#include "KernelDispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarDSP
+{
+    SpectrumBandReducer::SpectrumBandReducer(const SpectrumBandReducerConfig &config)
+        : config(config), bandCount(0), binCount(config.fftSize / 2), bandBegin({}), bandEnd({}), bandFrequency({}),
+          holdDb({}), holdRemaining({}), sequence(0)
+    {
+        const float binWidth = config.sampleRate / static_cast<float>(config.fftSize);
+        const float maxFrequency = std::min(config.maxFrequency, 0.5f * config.sampleRate);
+        if (binCount < 2 || config.sampleRate <= 0.0f || config.minFrequency <= 0.0f
+            || maxFrequency <= config.minFrequency)
+        {
+            return;
+        }
+
+        bandCount = std::min(config.bandCount, DisplayBands::MAX_BANDS);
+        const double ratio = static_cast<double>(maxFrequency) / config.minFrequency;
+        const auto lastBin = static_cast<double>(binCount - 1);
+
+        for (size_t band = 0; band < bandCount; ++band)
+        {
+            const double position = static_cast<double>(band) / static_cast<double>(bandCount);
+            const double lower = config.minFrequency * std::pow(ratio, position);
+            const double upper = config.minFrequency * std::pow(ratio, position + 1.0 / static_cast<double>(bandCount));
+            const double centre = std::sqrt(lower * upper);
+
+            // Bins whose centre lies in [lower, upper); DC is never part of a band
+            double begin = std::clamp(std::ceil(lower / binWidth), 1.0, lastBin);
+            double end = std::clamp(std::ceil(upper / binWidth), 1.0, static_cast<double>(binCount));
+            if (end <= begin)
+            {
+                // Band narrower than a bin: show the nearest bin
+                begin = std::clamp(std::round(centre / binWidth), 1.0, lastBin);
+                end = begin + 1.0;
+            }
+
+            bandBegin[band] = static_cast<uint32_t>(begin);
+            bandEnd[band] = static_cast<uint32_t>(end);
+            bandFrequency[band] = static_cast<float>(centre);
+        }
+
+        Reset();
+    }
+
+    bool SpectrumBandReducer::Process(std::span<const float> magnitudes, DisplayBands &output)
+    {
+        if (magnitudes.size() < binCount)
+        {
+            return false;
+        }
+
+        const KernelTable &kernels = GetKernels();
+        const float inverseReference = config.referenceMagnitude > 0.0f ? 1.0f / config.referenceMagnitude : 1.0f;
+        const float decayStep = config.peakDecayDbPerSecond * config.updateInterval;
+
+        for (size_t band = 0; band < bandCount; ++band)
+        {
+            const float *bins = magnitudes.data() + bandBegin[band];
+            const size_t count = bandEnd[band] - bandBegin[band];
+
+            const float peak = kernels.maximum(bins, count);
+            const auto mean = static_cast<float>(kernels.sum(bins, count) / static_cast<double>(count));
+            const float peakDb = ToDb(peak * inverseReference);
+
+            if (peakDb >= holdDb[band])
+            {
+                holdDb[band] = peakDb;
+                holdRemaining[band] = config.peakHoldSeconds;
+            }
+            else if (holdRemaining[band] > 0.0f)
+            {
+                holdRemaining[band] -= config.updateInterval;
+            }
+            else
+            {
+                holdDb[band] = std::max(peakDb, holdDb[band] - decayStep);
+            }
+
+            output.peakDb[band] = peakDb;
+            output.meanDb[band] = ToDb(mean * inverseReference);
+            output.holdDb[band] = holdDb[band];
+        }
+
+        output.bandCount = static_cast<uint32_t>(bandCount);
+        output.sequence = ++sequence;
+        return true;
+    }
+
+    size_t SpectrumBandReducer::GetBandCount() const
+    {
+        return bandCount;
+    }
+
+    float SpectrumBandReducer::GetBandFrequency(size_t band) const
+    {
+        return band < bandCount ? bandFrequency[band] : 0.0f;
+    }
+
+    size_t SpectrumBandReducer::GetBandBegin(size_t band) const
+    {
+        return band < bandCount ? bandBegin[band] : 0;
+    }
+
+    size_t SpectrumBandReducer::GetBandEnd(size_t band) const
+    {
+        return band < bandCount ? bandEnd[band] : 0;
+    }
+
+    void SpectrumBandReducer::Reset()
+    {
+        holdDb.fill(config.floorDb);
+        holdRemaining.fill(0.0f);
+        sequence = 0;
+    }
+
+    float SpectrumBandReducer::ToDb(float ratio) const
+    {
+        if (ratio <= 0.0f)
+        {
+            return config.floorDb;
+        }
+        return std::max(config.floorDb, 20.0f * std::log10(ratio));
+    }
+
+} // namespace GuitarDSP
@@ -0,0 +1,57 @@
+#include "SpectrumPublisher.h"
+#include "KernelDispatch.h"
+#include <algorithm>
+
+namespace GuitarDSP
+{
+    SpectrumSnapshot::SpectrumSnapshot(size_t fftSize, float sampleRate)
+        : spectrum(), magnitudes(fftSize / 2, 0.0f), sequence(0)
+    {
+        spectrum.data.resize(fftSize, 0.0f);
+        spectrum.fftSize = fftSize;
+        spectrum.sampleRate = sampleRate;
+    }
+
+    SpectrumPublisher::SpectrumPublisher(size_t fftSize, float sampleRate)
+        : buffers(fftSize, sampleRate), sequence(0)
+    {
+    }
+
+    void SpectrumPublisher::Publish(FFTProcessor &fft, std::span<const float> audioData)
+    {
+        SpectrumSnapshot &snapshot = buffers.GetWriteBuffer();
+        fft.ComputeSpectrum(audioData, snapshot.spectrum);
+        Commit(snapshot);
+    }
+
+    void SpectrumPublisher::Publish(const FFTSpectrum &spectrum)
+    {
+        SpectrumSnapshot &snapshot = buffers.GetWriteBuffer();
+
+        // Copy into the pre-allocated buffer only; never resize on the audio thread
+        const size_t count = std::min(spectrum.data.size(), snapshot.spectrum.data.size());
+        std::copy_n(spectrum.data.begin(), count, snapshot.spectrum.data.begin());
+        snapshot.spectrum.sampleRate = spectrum.sampleRate;
+        Commit(snapshot);
+    }
+
+    const SpectrumSnapshot &SpectrumPublisher::Read()
+    {
+        buffers.Update();
+        return buffers.GetReadBuffer();
+    }
+
+    bool SpectrumPublisher::HasNewSnapshot() const
+    {
+        return buffers.HasUpdate();
+    }
+
+    void SpectrumPublisher::Commit(SpectrumSnapshot &snapshot)
+    {
+        const size_t binCount = std::min(snapshot.magnitudes.size(), snapshot.spectrum.data.size() / 2);
+        GetKernels().complexMagnitude(snapshot.spectrum.data.data(), snapshot.magnitudes.data(), binCount);
+        snapshot.sequence = ++sequence;
+        buffers.Publish();
+    }
+
+} // namespace GuitarDSP
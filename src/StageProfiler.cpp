@@ -0,0 +1,140 @@
+#include "StageProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace GuitarDSP
+{
+    namespace
+    {
+        thread_local StageProfiler *activeProfiler = nullptr;
+
+        /**
+         * @brief Nearest-rank percentile of sorted samples
+         */
+        uint64_t Percentile(std::span<const uint64_t> sorted, double fraction)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+    } // namespace
+
+    StageProfiler::StageProfiler(const StageProfilerConfig &config)
+        : config(config), samples({}), sampleCounts({}), droppedCounts({})
+    {
+        // Pre-allocate sample storage (real-time safe)
+        for (auto &stageSamples : samples)
+        {
+            stageSamples.resize(config.maxSamplesPerStage, 0);
+        }
+    }
+
+    void StageProfiler::Record(ProfileStage stage, uint64_t cycles)
+    {
+        const auto index = static_cast<size_t>(stage);
+        if (index >= STAGE_COUNT)
+        {
+            return;
+        }
+
+        if (sampleCounts[index] < samples[index].size())
+        {
+            samples[index][sampleCounts[index]++] = cycles;
+        }
+        else
+        {
+            ++droppedCounts[index];
+        }
+    }
+
+    std::span<const uint64_t> StageProfiler::GetSamples(ProfileStage stage) const
+    {
+        const auto index = static_cast<size_t>(stage);
+        if (index >= STAGE_COUNT)
+        {
+            return {};
+        }
+
+        return std::span<const uint64_t>(samples[index]).first(sampleCounts[index]);
+    }
+
+    size_t StageProfiler::GetDroppedCount(ProfileStage stage) const
+    {
+        const auto index = static_cast<size_t>(stage);
+        return index < STAGE_COUNT ? droppedCounts[index] : 0;
+    }
+
+    StageStatistics StageProfiler::ComputeStatistics(ProfileStage stage) const
+    {
+        return ComputeStatistics(GetSamples(stage));
+    }
+
+    void StageProfiler::Reset()
+    {
+        sampleCounts.fill(0);
+        droppedCounts.fill(0);
+    }
+
+    StageStatistics StageProfiler::ComputeStatistics(std::span<const uint64_t> samples)
+    {
+        StageStatistics statistics{};
+        if (samples.empty())
+        {
+            return statistics;
+        }
+
+        std::vector<uint64_t> sorted(samples.begin(), samples.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        double total = 0.0;
+        for (const uint64_t value : sorted)
+        {
+            total += static_cast<double>(value);
+        }
+
+        statistics.count = sorted.size();
+        statistics.min = sorted.front();
+        statistics.mean = total / static_cast<double>(sorted.size());
+        statistics.p50 = Percentile(sorted, 0.50);
+        statistics.p99 = Percentile(sorted, 0.99);
+        statistics.p999 = Percentile(sorted, 0.999);
+        statistics.max = sorted.back();
+
+        return statistics;
+    }
+
+    const char *StageProfiler::GetStageName(ProfileStage stage)
+    {
+        switch (stage)
+        {
+        case ProfileStage::YinDifference:
+            return "yin.difference";
+        case ProfileStage::YinThreshold:
+            return "yin.threshold";
+        case ProfileStage::MpmNsdf:
+            return "mpm.nsdf";
+        case ProfileStage::MpmPeakPicking:
+            return "mpm.peaks";
+        case ProfileStage::HybridYin:
+            return "hybrid.yin";
+        case ProfileStage::HybridMpm:
+            return "hybrid.mpm";
+        case ProfileStage::HybridHarmonicRejection:
+            return "hybrid.harmonics";
+        case ProfileStage::Count:
+        default:
+            return "unknown";
+        }
+    }
+
+    void StageProfiler::SetActive(StageProfiler *profiler)
+    {
+        activeProfiler = profiler;
+    }
+
+    StageProfiler *StageProfiler::GetActive()
+    {
+        return activeProfiler;
+    }
+
+} // namespace GuitarDSP
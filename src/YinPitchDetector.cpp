@@ -1,4 +1,5 @@
 #include "YinPitchDetector.h"
+#include "StageProfiler.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -7,9 +8,8 @@ namespace GuitarDSP
 {
     YinPitchDetector::YinPitchDetector(const YinPitchDetectorConfig &config) : config(config), yinBuffer({})
     {
-        constexpr size_t maxExpectedFrames = 4096;
-        constexpr size_t maxYinBufferSize = maxExpectedFrames / 2;
-        yinBuffer.resize(maxYinBufferSize, 0.0f);
+        // Pre-allocate difference buffer (real-time safe)
+        yinBuffer.resize(config.maxBufferSize / 2, 0.0f);
     }
 
     YinPitchDetector::~YinPitchDetector() = default;
@@ -37,76 +37,255 @@ namespace GuitarDSP
         // Verify pre-allocated buffer is sufficient
         if (halfBufferSize > yinBuffer.size())
         {
-            // WARNING: Input buffer larger than pre-allocated yinBuffer!
-            // This should not happen with typical audio configurations (≤4096 frames).
-            // Options:
-            //  1. Increase maxExpectedFrames in constructor
-            //  2. Use smaller input buffers
-            //  3. Uncomment the resize below (causes allocation!)
+            // Input buffer larger than pre-allocated yinBuffer.
+            // Increase config.maxBufferSize rather than resizing here (allocation).
+            return std::nullopt;
+        }
+
+        if (config.adaptivePeriods > 0.0f)
+        {
+            switch (config.precision)
+            {
+            case AccumulationPrecision::Double:
+                return DetectAdaptive<DoubleAccumulation>(buffer, minTau, maxTau, sampleRate);
+            case AccumulationPrecision::Compensated:
+                return DetectAdaptive<CompensatedAccumulation>(buffer, minTau, maxTau, sampleRate);
+            case AccumulationPrecision::Float:
+            default:
+                return DetectAdaptive<FloatAccumulation>(buffer, minTau, maxTau, sampleRate);
+            }
+        }
 
-            // yinBuffer.resize(halfBufferSize, 0.0f); // Uncomment if needed
+        if (config.lazyEvaluation)
+        {
+            std::optional<size_t> tau;
+            switch (config.precision)
+            {
+            case AccumulationPrecision::Double:
+                tau = FindFirstDipLazy<DoubleAccumulation>(buffer, halfBufferSize, minTau, maxTau);
+                break;
+            case AccumulationPrecision::Compensated:
+                tau = FindFirstDipLazy<CompensatedAccumulation>(buffer, halfBufferSize, minTau, maxTau);
+                break;
+            case AccumulationPrecision::Float:
+            default:
+                tau = FindFirstDipLazy<FloatAccumulation>(buffer, halfBufferSize, minTau, maxTau);
+                break;
+            }
 
-            // For now, return error to avoid allocation
-            return std::nullopt;
+            if (!tau.has_value())
+            {
+                return std::nullopt;
+            }
+
+            return MakeResult(*tau, halfBufferSize, sampleRate);
         }
 
-        // Step 1: Calculate difference function
-        for (size_t tau = 0; tau < halfBufferSize; ++tau)
+        // Steps 1-2: Difference function and cumulative mean normalisation
+        switch (config.precision)
         {
-            float sum = 0.0f;
-            for (size_t i = 0; i < halfBufferSize; ++i)
+        case AccumulationPrecision::Double:
+            ComputeNormalizedDifference<DoubleAccumulation>(buffer, halfBufferSize);
+            break;
+        case AccumulationPrecision::Compensated:
+            ComputeNormalizedDifference<CompensatedAccumulation>(buffer, halfBufferSize);
+            break;
+        case AccumulationPrecision::Float:
+        default:
+            ComputeNormalizedDifference<FloatAccumulation>(buffer, halfBufferSize);
+            break;
+        }
+
+        // Step 3: Absolute threshold
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinThreshold);
+        size_t tau = minTau;
+        while (tau < maxTau)
+        {
+            if (yinBuffer[tau] < config.threshold)
             {
-                const float delta = buffer[i] - buffer[i + tau];
-                sum += delta * delta;
+                return MakeResult(tau, halfBufferSize, sampleRate);
             }
-            yinBuffer[tau] = sum;
+            ++tau;
+        }
+
+        return std::nullopt; // No pitch detected
+    }
+
+    template<typename Policy>
+    void YinPitchDetector::ComputeNormalizedDifference(std::span<const float> buffer, size_t halfBufferSize)
+    {
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinDifference);
+        const auto window = buffer.first(halfBufferSize);
+
+        // Step 1: Calculate difference function
+        for (size_t tau = 0; tau < halfBufferSize; ++tau)
+        {
+            const auto lagged = buffer.subspan(tau, halfBufferSize);
+            yinBuffer[tau] = static_cast<float>(SquaredDifferenceSum<Policy>(window, lagged));
         }
 
         // Step 2: Calculate cumulative mean normalized difference function
         yinBuffer[0] = 1.0f;
-        float runningSum = 0.0f;
+        typename Policy::Accumulator runningSum;
 
         for (size_t tau = 1; tau < halfBufferSize; ++tau)
         {
-            runningSum += yinBuffer[tau];
-            if (runningSum != 0.0f)
+            runningSum.Add(yinBuffer[tau]);
+            const double sum = runningSum.Value();
+            if (sum != 0.0)
             {
-                yinBuffer[tau] *= static_cast<float>(tau) / runningSum;
+                const double normalized = static_cast<double>(yinBuffer[tau]) * static_cast<double>(tau) / sum;
+                yinBuffer[tau] = static_cast<float>(normalized);
             }
             else
             {
                 yinBuffer[tau] = 1.0f;
             }
         }
+    }
 
-        // Step 3: Absolute threshold
-        size_t tau = minTau;
-        while (tau < maxTau)
+    template<typename Policy>
+    std::optional<size_t> YinPitchDetector::FindFirstDipLazy(std::span<const float> buffer,
+        size_t halfBufferSize,
+        size_t minTau,
+        size_t maxTau)
+    {
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinDifference);
+        const auto window = buffer.first(halfBufferSize);
+
+        yinBuffer[0] = 1.0f;
+        typename Policy::Accumulator runningSum;
+
+        // Steps 1-2 for a single lag; the running sum only needs lags up to tau
+        auto evaluate = [&](size_t tau) {
+            const auto lagged = buffer.subspan(tau, halfBufferSize);
+            const auto difference = static_cast<float>(SquaredDifferenceSum<Policy>(window, lagged));
+            runningSum.Add(difference);
+
+            const double sum = runningSum.Value();
+            if (sum != 0.0)
+            {
+                const double normalized = static_cast<double>(difference) * static_cast<double>(tau) / sum;
+                yinBuffer[tau] = static_cast<float>(normalized);
+            }
+            else
+            {
+                yinBuffer[tau] = 1.0f;
+            }
+        };
+
+        for (size_t tau = 1; tau < maxTau; ++tau)
         {
-            if (yinBuffer[tau] < config.threshold)
+            evaluate(tau);
+            if (tau < minTau || yinBuffer[tau] >= config.threshold)
             {
-                // Step 4: Parabolic interpolation for sub-sample accuracy
-                float betterTau = static_cast<float>(tau);
+                continue;
+            }
 
-                if (tau > 0 && tau < halfBufferSize - 1)
+            // Step 3: follow the dip to its minimum; the first larger lag is kept for interpolation
+            while (tau + 1 < halfBufferSize)
+            {
+                evaluate(tau + 1);
+                if (yinBuffer[tau + 1] >= yinBuffer[tau])
                 {
-                    const float s0 = yinBuffer[tau - 1];
-                    const float s1 = yinBuffer[tau];
-                    const float s2 = yinBuffer[tau + 1];
-
-                    const float adjustment = (s2 - s0) / (2.0f * (2.0f * s1 - s2 - s0));
-                    betterTau += adjustment;
+                    break;
                 }
+                ++tau;
+            }
+
+            return tau;
+        }
+
+        return std::nullopt;
+    }
+
+    template<typename Policy>
+    std::optional<PitchResult> YinPitchDetector::DetectAdaptive(std::span<const float> buffer,
+        size_t minTau,
+        size_t maxTau,
+        float sampleRate)
+    {
+        // Coarse: first dip on the newest samples, integrating one longest period
+        const size_t coarseHalfSize = maxTau + 1;
+        const auto coarse = FindFirstDipLazy<Policy>(buffer.last(2 * coarseHalfSize), coarseHalfSize, minTau, maxTau);
+        if (!coarse.has_value())
+        {
+            return std::nullopt;
+        }
+
+        const PitchResult coarseResult = MakeResult(*coarse, coarseHalfSize, sampleRate);
+        const float coarseTau = sampleRate / coarseResult.frequency;
+
+        // Refine: newest adaptivePeriods periods, lags near the coarse lag only
+        GUITAR_DSP_PROFILE_STAGE(ProfileStage::YinThreshold);
+        const float tolerance = config.adaptiveLagTolerance;
+        const size_t lowTau = std::max<size_t>(static_cast<size_t>(coarseTau * (1.0f - tolerance)), 2);
+        const size_t highTau =
+            std::min(static_cast<size_t>(std::ceil(coarseTau * (1.0f + tolerance))), yinBuffer.size() - 2);
+        if (lowTau >= highTau || highTau + 2 >= buffer.size())
+        {
+            return coarseResult;
+        }
 
-                const float frequency = sampleRate / betterTau;
-                const float confidence = 1.0f - yinBuffer[tau];
+        const auto periods = static_cast<size_t>(std::ceil(config.adaptivePeriods * coarseTau));
+        const size_t width = std::clamp<size_t>(periods, 1, buffer.size() - highTau - 2);
+        const auto segment = buffer.last(width + highTau + 2);
+        const auto window = segment.first(width);
 
-                return PitchResult{ frequency, confidence };
+        size_t tau = lowTau;
+        for (size_t lag = lowTau - 1; lag <= highTau + 1; ++lag)
+        {
+            yinBuffer[lag] = static_cast<float>(SquaredDifferenceSum<Policy>(window, segment.subspan(lag, width)));
+            if (lag >= lowTau && lag <= highTau && yinBuffer[lag] < yinBuffer[tau])
+            {
+                tau = lag;
             }
-            ++tau;
         }
 
-        return std::nullopt; // No pitch detected
+        if (tau == lowTau || tau == highTau)
+        {
+            return coarseResult;
+        }
+
+        float betterTau = static_cast<float>(tau);
+        const float s0 = yinBuffer[tau - 1];
+        const float s1 = yinBuffer[tau];
+        const float s2 = yinBuffer[tau + 1];
+        const float denominator = 2.0f * (2.0f * s1 - s2 - s0);
+        if (denominator != 0.0f)
+        {
+            betterTau += (s2 - s0) / denominator;
+        }
+
+        const double energy = SumOfSquares<Policy>(window) + SumOfSquares<Policy>(segment.subspan(tau, width));
+        if (energy <= 0.0)
+        {
+            return coarseResult;
+        }
+
+        const auto confidence = static_cast<float>(std::clamp(1.0 - static_cast<double>(s1) / energy, 0.0, 1.0));
+        return PitchResult{ sampleRate / betterTau, confidence };
+    }
+
+    PitchResult YinPitchDetector::MakeResult(size_t tau, size_t halfBufferSize, float sampleRate) const
+    {
+        // Step 4: Parabolic interpolation for sub-sample accuracy
+        float betterTau = static_cast<float>(tau);
+
+        if (tau > 0 && tau < halfBufferSize - 1)
+        {
+            const float s0 = yinBuffer[tau - 1];
+            const float s1 = yinBuffer[tau];
+            const float s2 = yinBuffer[tau + 1];
+
+            const float adjustment = (s2 - s0) / (2.0f * (2.0f * s1 - s2 - s0));
+            betterTau += adjustment;
+        }
+
+        const float frequency = sampleRate / betterTau;
+        const float confidence = 1.0f - yinBuffer[tau];
+
+        return PitchResult{ frequency, confidence };
     }
 
     void YinPitchDetector::Reset()
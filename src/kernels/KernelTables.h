@@ -0,0 +1,26 @@
+#pragma once
+
+#include "KernelDispatch.h"
+
+namespace GuitarDSP::Kernels
+{
+    /**
+     * @brief Per-ISA kernel tables (each defined in its own translation unit)
+     *
+     * Only the scalar table is always compiled. The others exist when CMake
+     * adds their translation unit for the target architecture, which it
+     * signals with GUITAR_DSP_HAVE_X86_KERNELS or GUITAR_DSP_HAVE_NEON_KERNELS.
+     */
+    const KernelTable &GetScalarKernels();
+
+#if defined(GUITAR_DSP_HAVE_X86_KERNELS)
+    const KernelTable &GetSse2Kernels();
+    const KernelTable &GetAvx2Kernels();
+    const KernelTable &GetAvx512Kernels();
+#endif
+
+#if defined(GUITAR_DSP_HAVE_NEON_KERNELS)
+    const KernelTable &GetNeonKernels();
+#endif
+
+} // namespace GuitarDSP::Kernels
@@ -0,0 +1,351 @@
+#include "KernelTables.h"
+#include <immintrin.h>
+#include <limits>
+
+// Compiled with ISA-specific flags: keep inline functions from other headers
+// out of this file so no ISA-specific copy of them can be picked by the linker.
+
+namespace GuitarDSP::Kernels
+{
+    namespace
+    {
+        double HorizontalSum(__m256 a, __m256 b)
+        {
+            alignas(32) float lanes[16];
+            _mm256_store_ps(lanes, a);
+            _mm256_store_ps(lanes + 8, b);
+
+            double total = 0.0;
+            for (const float lane : lanes)
+            {
+                total += lane;
+            }
+            return total;
+        }
+
+        double DotProduct(const float *a, const float *b, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+                sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * b[i];
+            }
+            return total;
+        }
+
+        double SquaredDifferenceSum(const float *a, const float *b, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m256 delta0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+                const __m256 delta1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+                sum0 = _mm256_fmadd_ps(delta0, delta0, sum0);
+                sum1 = _mm256_fmadd_ps(delta1, delta1, sum1);
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                const float delta = a[i] - b[i];
+                total += delta * delta;
+            }
+            return total;
+        }
+
+        double SumOfSquares(const float *a, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m256 value0 = _mm256_loadu_ps(a + i);
+                const __m256 value1 = _mm256_loadu_ps(a + i + 8);
+                sum0 = _mm256_fmadd_ps(value0, value0, sum0);
+                sum1 = _mm256_fmadd_ps(value1, value1, sum1);
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * a[i];
+            }
+            return total;
+        }
+
+        void ComplexMagnitude(const float *interleaved, float *magnitudes, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 low = _mm256_loadu_ps(interleaved + 2 * i);
+                const __m256 high = _mm256_loadu_ps(interleaved + 2 * i + 8);
+
+                // Shuffles work per 128-bit lane: restore element order afterwards
+                const __m256 real = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m256 imag = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+                const __m256 power = _mm256_fmadd_ps(real, real, _mm256_mul_ps(imag, imag));
+                const __m256 ordered = _mm256_castpd_ps(
+                    _mm256_permute4x64_pd(_mm256_castps_pd(power), _MM_SHUFFLE(3, 1, 2, 0)));
+                _mm256_storeu_ps(magnitudes + i, _mm256_sqrt_ps(ordered));
+            }
+
+            for (; i < count; ++i)
+            {
+                const float real = interleaved[2 * i];
+                const float imag = interleaved[2 * i + 1];
+                magnitudes[i] = _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(real * real + imag * imag)));
+            }
+        }
+
+        double Sum(const float *a, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(a + i));
+                sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(a + i + 8));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i];
+            }
+            return total;
+        }
+
+        float Maximum(const float *a, size_t count)
+        {
+            const __m256 lowest = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+            __m256 max0 = lowest;
+            __m256 max1 = lowest;
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                max0 = _mm256_max_ps(max0, _mm256_loadu_ps(a + i));
+                max1 = _mm256_max_ps(max1, _mm256_loadu_ps(a + i + 8));
+            }
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, _mm256_max_ps(max0, max1));
+
+            float result = lanes[0];
+            for (const float lane : lanes)
+            {
+                result = lane > result ? lane : result;
+            }
+            for (; i < count; ++i)
+            {
+                result = a[i] > result ? a[i] : result;
+            }
+            return result;
+        }
+
+        double HorizontalSum(__m256d a, __m256d b)
+        {
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+
+        /**
+         * @brief Adds value to sum with Kahan compensation in every lane
+         */
+        void CompensatedAdd(__m256 &sum, __m256 &compensation, __m256 value)
+        {
+            const __m256 corrected = _mm256_sub_ps(value, compensation);
+            const __m256 next = _mm256_add_ps(sum, corrected);
+            compensation = _mm256_sub_ps(_mm256_sub_ps(next, sum), corrected);
+            sum = next;
+        }
+
+        double CompensatedTotal(__m256 sum, __m256 compensation)
+        {
+            alignas(32) float sums[8];
+            alignas(32) float compensations[8];
+            _mm256_store_ps(sums, sum);
+            _mm256_store_ps(compensations, compensation);
+
+            double total = 0.0;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                total += static_cast<double>(sums[lane]) - static_cast<double>(compensations[lane]);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Adds a * b or (a - b)^2 of four floats, widened to double, to sum
+         */
+        template<bool Difference>
+        __m256d AddTermsDouble(__m128 a, __m128 b, __m256d sum)
+        {
+            const __m256d x = _mm256_cvtps_pd(a);
+            const __m256d y = _mm256_cvtps_pd(b);
+            if constexpr (Difference)
+            {
+                const __m256d delta = _mm256_sub_pd(x, y);
+                return _mm256_fmadd_pd(delta, delta, sum);
+            }
+            else
+            {
+                return _mm256_fmadd_pd(x, y, sum);
+            }
+        }
+
+        /**
+         * @brief Returns float terms a * b or (a - b)^2
+         */
+        template<bool Difference>
+        __m256 Terms(__m256 a, __m256 b)
+        {
+            if constexpr (Difference)
+            {
+                const __m256 delta = _mm256_sub_ps(a, b);
+                return _mm256_mul_ps(delta, delta);
+            }
+            else
+            {
+                return _mm256_mul_ps(a, b);
+            }
+        }
+
+        template<bool Difference>
+        double AccumulateDouble(const float *a, const float *b, size_t count)
+        {
+            __m256d sum0 = _mm256_setzero_pd();
+            __m256d sum1 = _mm256_setzero_pd();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = AddTermsDouble<Difference>(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i), sum0);
+                sum1 = AddTermsDouble<Difference>(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4), sum1);
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                alignas(32) float tailA[8] = {};
+                alignas(32) float tailB[8] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                sum0 = AddTermsDouble<Difference>(_mm_load_ps(tailA), _mm_load_ps(tailB), sum0);
+                sum1 = AddTermsDouble<Difference>(_mm_load_ps(tailA + 4), _mm_load_ps(tailB + 4), sum1);
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        template<bool Difference>
+        double AccumulateCompensated(const float *a, const float *b, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            __m256 compensation0 = _mm256_setzero_ps();
+            __m256 compensation1 = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+                CompensatedAdd(sum1,
+                    compensation1,
+                    Terms<Difference>(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                alignas(32) float tailA[16] = {};
+                alignas(32) float tailB[16] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(_mm256_load_ps(tailA), _mm256_load_ps(tailB)));
+                CompensatedAdd(sum1,
+                    compensation1,
+                    Terms<Difference>(_mm256_load_ps(tailA + 8), _mm256_load_ps(tailB + 8)));
+            }
+
+            return CompensatedTotal(sum0, compensation0) + CompensatedTotal(sum1, compensation1);
+        }
+
+        double DotProductDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<true>(a, b, count);
+        }
+
+        double SumOfSquaresDouble(const float *a, size_t count)
+        {
+            return AccumulateDouble<false>(a, a, count);
+        }
+
+        double DotProductCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<true>(a, b, count);
+        }
+
+        double SumOfSquaresCompensated(const float *a, size_t count)
+        {
+            return AccumulateCompensated<false>(a, a, count);
+        }
+
+        constexpr KernelTable AVX2_KERNELS = {
+            IsaLevel::Avx2,
+            DotProduct,
+            SquaredDifferenceSum,
+            SumOfSquares,
+            ComplexMagnitude,
+            Sum,
+            Maximum,
+            DotProductDouble,
+            SquaredDifferenceSumDouble,
+            SumOfSquaresDouble,
+            DotProductCompensated,
+            SquaredDifferenceSumCompensated,
+            SumOfSquaresCompensated,
+        };
+    } // namespace
+
+    const KernelTable &GetAvx2Kernels()
+    {
+        return AVX2_KERNELS;
+    }
+
+} // namespace GuitarDSP::Kernels
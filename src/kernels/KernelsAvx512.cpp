@@ -0,0 +1,372 @@
+#include "KernelTables.h"
+#include <immintrin.h>
+#include <limits>
+
+// Compiled with ISA-specific flags: keep inline functions from other headers
+// out of this file so no ISA-specific copy of them can be picked by the linker.
+
+namespace GuitarDSP::Kernels
+{
+    namespace
+    {
+        double HorizontalSum(__m512 a, __m512 b)
+        {
+            alignas(64) float lanes[32];
+            _mm512_store_ps(lanes, a);
+            _mm512_store_ps(lanes + 16, b);
+
+            double total = 0.0;
+            for (const float lane : lanes)
+            {
+                total += lane;
+            }
+            return total;
+        }
+
+        __mmask16 TailMask(size_t remaining)
+        {
+            return static_cast<__mmask16>((1u << remaining) - 1u);
+        }
+
+        double DotProduct(const float *a, const float *b, size_t count)
+        {
+            __m512 sum0 = _mm512_setzero_ps();
+            __m512 sum1 = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum0);
+                sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), sum1);
+            }
+
+            // Masked loads cover the tail without a scalar loop
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                sum0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), sum0);
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        double SquaredDifferenceSum(const float *a, const float *b, size_t count)
+        {
+            __m512 sum0 = _mm512_setzero_ps();
+            __m512 sum1 = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                const __m512 delta0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+                const __m512 delta1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+                sum0 = _mm512_fmadd_ps(delta0, delta0, sum0);
+                sum1 = _mm512_fmadd_ps(delta1, delta1, sum1);
+            }
+
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                const __m512 delta =
+                    _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i));
+                sum0 = _mm512_fmadd_ps(delta, delta, sum0);
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        double SumOfSquares(const float *a, size_t count)
+        {
+            __m512 sum0 = _mm512_setzero_ps();
+            __m512 sum1 = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                const __m512 value0 = _mm512_loadu_ps(a + i);
+                const __m512 value1 = _mm512_loadu_ps(a + i + 16);
+                sum0 = _mm512_fmadd_ps(value0, value0, sum0);
+                sum1 = _mm512_fmadd_ps(value1, value1, sum1);
+            }
+
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                const __m512 value = _mm512_maskz_loadu_ps(mask, a + i);
+                sum0 = _mm512_fmadd_ps(value, value, sum0);
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        void ComplexMagnitude(const float *interleaved, float *magnitudes, size_t count)
+        {
+            const __m512i realIndex = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+            const __m512i imagIndex = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 low = _mm512_loadu_ps(interleaved + 2 * i);
+                const __m512 high = _mm512_loadu_ps(interleaved + 2 * i + 16);
+                const __m512 real = _mm512_permutex2var_ps(low, realIndex, high);
+                const __m512 imag = _mm512_permutex2var_ps(low, imagIndex, high);
+                const __m512 power = _mm512_fmadd_ps(real, real, _mm512_mul_ps(imag, imag));
+                // Zero-masked form: _mm512_sqrt_ps trips -Wmaybe-uninitialized in GCC 12 headers
+                _mm512_storeu_ps(magnitudes + i, _mm512_maskz_sqrt_ps(static_cast<__mmask16>(0xFFFF), power));
+            }
+
+            for (; i < count; ++i)
+            {
+                const float real = interleaved[2 * i];
+                const float imag = interleaved[2 * i + 1];
+                magnitudes[i] = _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(real * real + imag * imag)));
+            }
+        }
+
+        double Sum(const float *a, size_t count)
+        {
+            __m512 sum0 = _mm512_setzero_ps();
+            __m512 sum1 = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                sum0 = _mm512_add_ps(sum0, _mm512_loadu_ps(a + i));
+                sum1 = _mm512_add_ps(sum1, _mm512_loadu_ps(a + i + 16));
+            }
+
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                sum0 = _mm512_add_ps(sum0, _mm512_maskz_loadu_ps(mask, a + i));
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        __m512 Max(__m512 a, __m512 b)
+        {
+            // Zero-masked form: _mm512_max_ps trips -Wmaybe-uninitialized in GCC 12 headers
+            return _mm512_maskz_max_ps(static_cast<__mmask16>(0xFFFF), a, b);
+        }
+
+        float Maximum(const float *a, size_t count)
+        {
+            const __m512 lowest = _mm512_set1_ps(-std::numeric_limits<float>::infinity());
+            __m512 max0 = lowest;
+            __m512 max1 = lowest;
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                max0 = Max(max0, _mm512_loadu_ps(a + i));
+                max1 = Max(max1, _mm512_loadu_ps(a + i + 16));
+            }
+
+            // Masked-off tail lanes keep -infinity
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                max0 = Max(max0, _mm512_mask_loadu_ps(lowest, mask, a + i));
+            }
+
+            alignas(64) float lanes[16];
+            _mm512_store_ps(lanes, Max(max0, max1));
+
+            float result = lanes[0];
+            for (const float lane : lanes)
+            {
+                result = lane > result ? lane : result;
+            }
+            return result;
+        }
+
+        double HorizontalSum(__m512d a, __m512d b)
+        {
+            alignas(64) double lanes[8];
+            _mm512_store_pd(lanes, _mm512_add_pd(a, b));
+
+            double total = 0.0;
+            for (const double lane : lanes)
+            {
+                total += lane;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Adds value to sum with Kahan compensation in every lane
+         */
+        void CompensatedAdd(__m512 &sum, __m512 &compensation, __m512 value)
+        {
+            const __m512 corrected = _mm512_sub_ps(value, compensation);
+            const __m512 next = _mm512_add_ps(sum, corrected);
+            compensation = _mm512_sub_ps(_mm512_sub_ps(next, sum), corrected);
+            sum = next;
+        }
+
+        double CompensatedTotal(__m512 sum, __m512 compensation)
+        {
+            alignas(64) float sums[16];
+            alignas(64) float compensations[16];
+            _mm512_store_ps(sums, sum);
+            _mm512_store_ps(compensations, compensation);
+
+            double total = 0.0;
+            for (size_t lane = 0; lane < 16; ++lane)
+            {
+                total += static_cast<double>(sums[lane]) - static_cast<double>(compensations[lane]);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Adds a * b or (a - b)^2 of eight floats, widened to double, to sum
+         *
+         * Zero-masked conversions: the unmasked forms pass an undefined source
+         * register that GCC reports as maybe-uninitialized.
+         */
+        template<bool Difference>
+        __m512d AddTermsDouble(__m256 a, __m256 b, __m512d sum)
+        {
+            const __m512d x = _mm512_maskz_cvtps_pd(0xFF, a);
+            const __m512d y = _mm512_maskz_cvtps_pd(0xFF, b);
+            if constexpr (Difference)
+            {
+                const __m512d delta = _mm512_sub_pd(x, y);
+                return _mm512_fmadd_pd(delta, delta, sum);
+            }
+            else
+            {
+                return _mm512_fmadd_pd(x, y, sum);
+            }
+        }
+
+        /**
+         * @brief Returns lower (Half = 0) or upper (Half = 1) eight floats of a 16-float register
+         */
+        template<int Half>
+        __m256 ExtractHalf(__m512 values)
+        {
+            return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(values), Half));
+        }
+
+        /**
+         * @brief Returns float terms a * b or (a - b)^2
+         */
+        template<bool Difference>
+        __m512 Terms(__m512 a, __m512 b)
+        {
+            if constexpr (Difference)
+            {
+                const __m512 delta = _mm512_sub_ps(a, b);
+                return _mm512_mul_ps(delta, delta);
+            }
+            else
+            {
+                return _mm512_mul_ps(a, b);
+            }
+        }
+
+        template<bool Difference>
+        double AccumulateDouble(const float *a, const float *b, size_t count)
+        {
+            __m512d sum0 = _mm512_setzero_pd();
+            __m512d sum1 = _mm512_setzero_pd();
+
+            // Masked loads zero the tail, which adds nothing to either term
+            for (size_t i = 0; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                const __m512 valuesA = _mm512_maskz_loadu_ps(mask, a + i);
+                const __m512 valuesB = _mm512_maskz_loadu_ps(mask, b + i);
+                sum0 = AddTermsDouble<Difference>(ExtractHalf<0>(valuesA), ExtractHalf<0>(valuesB), sum0);
+                sum1 = AddTermsDouble<Difference>(ExtractHalf<1>(valuesA), ExtractHalf<1>(valuesB), sum1);
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        template<bool Difference>
+        double AccumulateCompensated(const float *a, const float *b, size_t count)
+        {
+            __m512 sum0 = _mm512_setzero_ps();
+            __m512 sum1 = _mm512_setzero_ps();
+            __m512 compensation0 = _mm512_setzero_ps();
+            __m512 compensation1 = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+                CompensatedAdd(sum1,
+                    compensation1,
+                    Terms<Difference>(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16)));
+            }
+
+            // Masked loads zero the tail, which adds nothing to either term
+            for (; i < count; i += 16)
+            {
+                const __mmask16 mask = count - i >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(count - i);
+                CompensatedAdd(sum0,
+                    compensation0,
+                    Terms<Difference>(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+            }
+
+            return CompensatedTotal(sum0, compensation0) + CompensatedTotal(sum1, compensation1);
+        }
+
+        double DotProductDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<true>(a, b, count);
+        }
+
+        double SumOfSquaresDouble(const float *a, size_t count)
+        {
+            return AccumulateDouble<false>(a, a, count);
+        }
+
+        double DotProductCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<true>(a, b, count);
+        }
+
+        double SumOfSquaresCompensated(const float *a, size_t count)
+        {
+            return AccumulateCompensated<false>(a, a, count);
+        }
+
+        constexpr KernelTable AVX512_KERNELS = {
+            IsaLevel::Avx512,
+            DotProduct,
+            SquaredDifferenceSum,
+            SumOfSquares,
+            ComplexMagnitude,
+            Sum,
+            Maximum,
+            DotProductDouble,
+            SquaredDifferenceSumDouble,
+            SumOfSquaresDouble,
+            DotProductCompensated,
+            SquaredDifferenceSumCompensated,
+            SumOfSquaresCompensated,
+        };
+    } // namespace
+
+    const KernelTable &GetAvx512Kernels()
+    {
+        return AVX512_KERNELS;
+    }
+
+} // namespace GuitarDSP::Kernels
@@ -0,0 +1,319 @@
+#include "KernelTables.h"
+#include <arm_neon.h>
+#include <limits>
+
+namespace GuitarDSP::Kernels
+{
+    namespace
+    {
+        double HorizontalSum(float32x4_t a, float32x4_t b)
+        {
+            return static_cast<double>(vaddvq_f32(a)) + static_cast<double>(vaddvq_f32(b));
+        }
+
+        double DotProduct(const float *a, const float *b, size_t count)
+        {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = vfmaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+                sum1 = vfmaq_f32(sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * b[i];
+            }
+            return total;
+        }
+
+        double SquaredDifferenceSum(const float *a, const float *b, size_t count)
+        {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const float32x4_t delta0 = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+                const float32x4_t delta1 = vsubq_f32(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+                sum0 = vfmaq_f32(sum0, delta0, delta0);
+                sum1 = vfmaq_f32(sum1, delta1, delta1);
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                const float delta = a[i] - b[i];
+                total += delta * delta;
+            }
+            return total;
+        }
+
+        double SumOfSquares(const float *a, size_t count)
+        {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const float32x4_t value0 = vld1q_f32(a + i);
+                const float32x4_t value1 = vld1q_f32(a + i + 4);
+                sum0 = vfmaq_f32(sum0, value0, value0);
+                sum1 = vfmaq_f32(sum1, value1, value1);
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * a[i];
+            }
+            return total;
+        }
+
+        void ComplexMagnitude(const float *interleaved, float *magnitudes, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                // De-interleaving load splits real and imaginary parts
+                const float32x4x2_t values = vld2q_f32(interleaved + 2 * i);
+                const float32x4_t imagPower = vmulq_f32(values.val[1], values.val[1]);
+                const float32x4_t power = vfmaq_f32(imagPower, values.val[0], values.val[0]);
+                vst1q_f32(magnitudes + i, vsqrtq_f32(power));
+            }
+
+            for (; i < count; ++i)
+            {
+                const float real = interleaved[2 * i];
+                const float imag = interleaved[2 * i + 1];
+                magnitudes[i] = vget_lane_f32(vsqrt_f32(vdup_n_f32(real * real + imag * imag)), 0);
+            }
+        }
+
+        double Sum(const float *a, size_t count)
+        {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = vaddq_f32(sum0, vld1q_f32(a + i));
+                sum1 = vaddq_f32(sum1, vld1q_f32(a + i + 4));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i];
+            }
+            return total;
+        }
+
+        float Maximum(const float *a, size_t count)
+        {
+            const float32x4_t lowest = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+            float32x4_t max0 = lowest;
+            float32x4_t max1 = lowest;
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                max0 = vmaxq_f32(max0, vld1q_f32(a + i));
+                max1 = vmaxq_f32(max1, vld1q_f32(a + i + 4));
+            }
+
+            float result = vmaxvq_f32(vmaxq_f32(max0, max1));
+            for (; i < count; ++i)
+            {
+                result = a[i] > result ? a[i] : result;
+            }
+            return result;
+        }
+
+        double HorizontalSum(float64x2_t a, float64x2_t b)
+        {
+            return vaddvq_f64(vaddq_f64(a, b));
+        }
+
+        /**
+         * @brief Adds value to sum with Kahan compensation in every lane
+         */
+        void CompensatedAdd(float32x4_t &sum, float32x4_t &compensation, float32x4_t value)
+        {
+            const float32x4_t corrected = vsubq_f32(value, compensation);
+            const float32x4_t next = vaddq_f32(sum, corrected);
+            compensation = vsubq_f32(vsubq_f32(next, sum), corrected);
+            sum = next;
+        }
+
+        double CompensatedTotal(float32x4_t sum, float32x4_t compensation)
+        {
+            const float64x2_t low =
+                vsubq_f64(vcvt_f64_f32(vget_low_f32(sum)), vcvt_f64_f32(vget_low_f32(compensation)));
+            const float64x2_t high =
+                vsubq_f64(vcvt_f64_f32(vget_high_f32(sum)), vcvt_f64_f32(vget_high_f32(compensation)));
+            return HorizontalSum(low, high);
+        }
+
+        /**
+         * @brief Adds a * b or (a - b)^2 of two floats, widened to double, to sum
+         */
+        template<bool Difference>
+        float64x2_t AddTermsDouble(float32x2_t a, float32x2_t b, float64x2_t sum)
+        {
+            const float64x2_t x = vcvt_f64_f32(a);
+            const float64x2_t y = vcvt_f64_f32(b);
+            if constexpr (Difference)
+            {
+                const float64x2_t delta = vsubq_f64(x, y);
+                return vfmaq_f64(sum, delta, delta);
+            }
+            else
+            {
+                return vfmaq_f64(sum, x, y);
+            }
+        }
+
+        /**
+         * @brief Returns float terms a * b or (a - b)^2
+         */
+        template<bool Difference>
+        float32x4_t Terms(float32x4_t a, float32x4_t b)
+        {
+            if constexpr (Difference)
+            {
+                const float32x4_t delta = vsubq_f32(a, b);
+                return vmulq_f32(delta, delta);
+            }
+            else
+            {
+                return vmulq_f32(a, b);
+            }
+        }
+
+        template<bool Difference>
+        double AccumulateDouble(const float *a, const float *b, size_t count)
+        {
+            float64x2_t sum0 = vdupq_n_f64(0.0);
+            float64x2_t sum1 = vdupq_n_f64(0.0);
+
+            // Low and high float pairs go to separate accumulators
+            auto add = [&sum0, &sum1](float32x4_t valuesA, float32x4_t valuesB) {
+                sum0 = AddTermsDouble<Difference>(vget_low_f32(valuesA), vget_low_f32(valuesB), sum0);
+                sum1 = AddTermsDouble<Difference>(vget_high_f32(valuesA), vget_high_f32(valuesB), sum1);
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                add(vld1q_f32(a + i), vld1q_f32(b + i));
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                float tailA[4] = {};
+                float tailB[4] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                add(vld1q_f32(tailA), vld1q_f32(tailB));
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        template<bool Difference>
+        double AccumulateCompensated(const float *a, const float *b, size_t count)
+        {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+            float32x4_t compensation0 = vdupq_n_f32(0.0f);
+            float32x4_t compensation1 = vdupq_n_f32(0.0f);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(vld1q_f32(a + i), vld1q_f32(b + i)));
+                CompensatedAdd(sum1, compensation1, Terms<Difference>(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4)));
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                float tailA[8] = {};
+                float tailB[8] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(vld1q_f32(tailA), vld1q_f32(tailB)));
+                CompensatedAdd(sum1, compensation1, Terms<Difference>(vld1q_f32(tailA + 4), vld1q_f32(tailB + 4)));
+            }
+
+            return CompensatedTotal(sum0, compensation0) + CompensatedTotal(sum1, compensation1);
+        }
+
+        double DotProductDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<true>(a, b, count);
+        }
+
+        double SumOfSquaresDouble(const float *a, size_t count)
+        {
+            return AccumulateDouble<false>(a, a, count);
+        }
+
+        double DotProductCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<true>(a, b, count);
+        }
+
+        double SumOfSquaresCompensated(const float *a, size_t count)
+        {
+            return AccumulateCompensated<false>(a, a, count);
+        }
+
+        constexpr KernelTable NEON_KERNELS = {
+            IsaLevel::Neon,
+            DotProduct,
+            SquaredDifferenceSum,
+            SumOfSquares,
+            ComplexMagnitude,
+            Sum,
+            Maximum,
+            DotProductDouble,
+            SquaredDifferenceSumDouble,
+            SumOfSquaresDouble,
+            DotProductCompensated,
+            SquaredDifferenceSumCompensated,
+            SumOfSquaresCompensated,
+        };
+    } // namespace
+
+    const KernelTable &GetNeonKernels()
+    {
+        return NEON_KERNELS;
+    }
+
+} // namespace GuitarDSP::Kernels
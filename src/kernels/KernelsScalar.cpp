@@ -0,0 +1,127 @@
+#include "AccumulationPolicy.h"
+#include "KernelTables.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GuitarDSP::Kernels
+{
+    namespace
+    {
+        double DotProduct(const float *a, const float *b, size_t count)
+        {
+            return Detail::AccumulateLanes<FloatAccumulation>(count, [a, b](size_t i) { return a[i] * b[i]; });
+        }
+
+        double SquaredDifferenceSum(const float *a, const float *b, size_t count)
+        {
+            return Detail::AccumulateLanes<FloatAccumulation>(count, [a, b](size_t i) {
+                const float delta = a[i] - b[i];
+                return delta * delta;
+            });
+        }
+
+        double SumOfSquares(const float *a, size_t count)
+        {
+            return Detail::AccumulateLanes<FloatAccumulation>(count, [a](size_t i) { return a[i] * a[i]; });
+        }
+
+        void ComplexMagnitude(const float *interleaved, float *magnitudes, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float real = interleaved[2 * i];
+                const float imag = interleaved[2 * i + 1];
+                magnitudes[i] = std::sqrt(real * real + imag * imag);
+            }
+        }
+
+        double Sum(const float *a, size_t count)
+        {
+            return Detail::AccumulateLanes<FloatAccumulation>(count, [a](size_t i) { return a[i]; });
+        }
+
+        float Maximum(const float *a, size_t count)
+        {
+            float result = -std::numeric_limits<float>::infinity();
+            for (size_t i = 0; i < count; ++i)
+            {
+                result = std::max(result, a[i]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Lane-blocked sum of products or squared differences under a policy
+         */
+        template<typename Policy, bool Difference>
+        double Accumulate(const float *a, const float *b, size_t count)
+        {
+            using Term = typename Policy::Term;
+            return Detail::AccumulateLanes<Policy>(count, [a, b](size_t i) {
+                const auto x = static_cast<Term>(a[i]);
+                const auto y = static_cast<Term>(b[i]);
+                if constexpr (Difference)
+                {
+                    return (x - y) * (x - y);
+                }
+                else
+                {
+                    return x * y;
+                }
+            });
+        }
+
+        double DotProductDouble(const float *a, const float *b, size_t count)
+        {
+            return Accumulate<DoubleAccumulation, false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumDouble(const float *a, const float *b, size_t count)
+        {
+            return Accumulate<DoubleAccumulation, true>(a, b, count);
+        }
+
+        double SumOfSquaresDouble(const float *a, size_t count)
+        {
+            return Accumulate<DoubleAccumulation, false>(a, a, count);
+        }
+
+        double DotProductCompensated(const float *a, const float *b, size_t count)
+        {
+            return Accumulate<CompensatedAccumulation, false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumCompensated(const float *a, const float *b, size_t count)
+        {
+            return Accumulate<CompensatedAccumulation, true>(a, b, count);
+        }
+
+        double SumOfSquaresCompensated(const float *a, size_t count)
+        {
+            return Accumulate<CompensatedAccumulation, false>(a, a, count);
+        }
+
+        constexpr KernelTable SCALAR_KERNELS = {
+            IsaLevel::Scalar,
+            DotProduct,
+            SquaredDifferenceSum,
+            SumOfSquares,
+            ComplexMagnitude,
+            Sum,
+            Maximum,
+            DotProductDouble,
+            SquaredDifferenceSumDouble,
+            SumOfSquaresDouble,
+            DotProductCompensated,
+            SquaredDifferenceSumCompensated,
+            SumOfSquaresCompensated,
+        };
+    } // namespace
+
+    const KernelTable &GetScalarKernels()
+    {
+        return SCALAR_KERNELS;
+    }
+
+} // namespace GuitarDSP::Kernels
@@ -0,0 +1,350 @@
+#include "KernelTables.h"
+#include <emmintrin.h>
+#include <limits>
+
+// Compiled with ISA-specific flags: keep inline functions from other headers
+// out of this file so no ISA-specific copy of them can be picked by the linker.
+
+namespace GuitarDSP::Kernels
+{
+    namespace
+    {
+        double HorizontalSum(__m128 a, __m128 b)
+        {
+            alignas(16) float lanes[8];
+            _mm_store_ps(lanes, a);
+            _mm_store_ps(lanes + 4, b);
+
+            double total = 0.0;
+            for (const float lane : lanes)
+            {
+                total += lane;
+            }
+            return total;
+        }
+
+        double DotProduct(const float *a, const float *b, size_t count)
+        {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * b[i];
+            }
+            return total;
+        }
+
+        double SquaredDifferenceSum(const float *a, const float *b, size_t count)
+        {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128 delta0 = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+                const __m128 delta1 = _mm_sub_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4));
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(delta0, delta0));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(delta1, delta1));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                const float delta = a[i] - b[i];
+                total += delta * delta;
+            }
+            return total;
+        }
+
+        double SumOfSquares(const float *a, size_t count)
+        {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128 value0 = _mm_loadu_ps(a + i);
+                const __m128 value1 = _mm_loadu_ps(a + i + 4);
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(value0, value0));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(value1, value1));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i] * a[i];
+            }
+            return total;
+        }
+
+        void ComplexMagnitude(const float *interleaved, float *magnitudes, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 low = _mm_loadu_ps(interleaved + 2 * i);
+                const __m128 high = _mm_loadu_ps(interleaved + 2 * i + 4);
+                const __m128 real = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m128 imag = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+                const __m128 power = _mm_add_ps(_mm_mul_ps(real, real), _mm_mul_ps(imag, imag));
+                _mm_storeu_ps(magnitudes + i, _mm_sqrt_ps(power));
+            }
+
+            for (; i < count; ++i)
+            {
+                const float real = interleaved[2 * i];
+                const float imag = interleaved[2 * i + 1];
+                magnitudes[i] = _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(real * real + imag * imag)));
+            }
+        }
+
+        double Sum(const float *a, size_t count)
+        {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_loadu_ps(a + i));
+                sum1 = _mm_add_ps(sum1, _mm_loadu_ps(a + i + 4));
+            }
+
+            double total = HorizontalSum(sum0, sum1);
+            for (; i < count; ++i)
+            {
+                total += a[i];
+            }
+            return total;
+        }
+
+        float Maximum(const float *a, size_t count)
+        {
+            const __m128 lowest = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            __m128 max0 = lowest;
+            __m128 max1 = lowest;
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                max0 = _mm_max_ps(max0, _mm_loadu_ps(a + i));
+                max1 = _mm_max_ps(max1, _mm_loadu_ps(a + i + 4));
+            }
+
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, _mm_max_ps(max0, max1));
+
+            float result = lanes[0];
+            for (const float lane : lanes)
+            {
+                result = lane > result ? lane : result;
+            }
+            for (; i < count; ++i)
+            {
+                result = a[i] > result ? a[i] : result;
+            }
+            return result;
+        }
+
+        double HorizontalSum(__m128d a, __m128d b)
+        {
+            alignas(16) double lanes[2];
+            _mm_store_pd(lanes, _mm_add_pd(a, b));
+            return lanes[0] + lanes[1];
+        }
+
+        /**
+         * @brief Adds value to sum with Kahan compensation in every lane
+         */
+        void CompensatedAdd(__m128 &sum, __m128 &compensation, __m128 value)
+        {
+            const __m128 corrected = _mm_sub_ps(value, compensation);
+            const __m128 next = _mm_add_ps(sum, corrected);
+            compensation = _mm_sub_ps(_mm_sub_ps(next, sum), corrected);
+            sum = next;
+        }
+
+        double CompensatedTotal(__m128 sum, __m128 compensation)
+        {
+            alignas(16) float sums[4];
+            alignas(16) float compensations[4];
+            _mm_store_ps(sums, sum);
+            _mm_store_ps(compensations, compensation);
+
+            double total = 0.0;
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                total += static_cast<double>(sums[lane]) - static_cast<double>(compensations[lane]);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Adds a * b or (a - b)^2 of two floats, widened to double, to sum
+         */
+        template<bool Difference>
+        __m128d AddTermsDouble(__m128 a, __m128 b, __m128d sum)
+        {
+            const __m128d x = _mm_cvtps_pd(a);
+            const __m128d y = _mm_cvtps_pd(b);
+            if constexpr (Difference)
+            {
+                const __m128d delta = _mm_sub_pd(x, y);
+                return _mm_add_pd(sum, _mm_mul_pd(delta, delta));
+            }
+            else
+            {
+                return _mm_add_pd(sum, _mm_mul_pd(x, y));
+            }
+        }
+
+        /**
+         * @brief Returns float terms a * b or (a - b)^2
+         */
+        template<bool Difference>
+        __m128 Terms(__m128 a, __m128 b)
+        {
+            if constexpr (Difference)
+            {
+                const __m128 delta = _mm_sub_ps(a, b);
+                return _mm_mul_ps(delta, delta);
+            }
+            else
+            {
+                return _mm_mul_ps(a, b);
+            }
+        }
+
+        template<bool Difference>
+        double AccumulateDouble(const float *a, const float *b, size_t count)
+        {
+            __m128d sum0 = _mm_setzero_pd();
+            __m128d sum1 = _mm_setzero_pd();
+
+            // Low and high float pairs go to separate accumulators
+            auto add = [&sum0, &sum1](__m128 valuesA, __m128 valuesB) {
+                sum0 = AddTermsDouble<Difference>(valuesA, valuesB, sum0);
+                sum1 = AddTermsDouble<Difference>(
+                    _mm_movehl_ps(valuesA, valuesA), _mm_movehl_ps(valuesB, valuesB), sum1);
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                add(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                alignas(16) float tailA[4] = {};
+                alignas(16) float tailB[4] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                add(_mm_load_ps(tailA), _mm_load_ps(tailB));
+            }
+
+            return HorizontalSum(sum0, sum1);
+        }
+
+        template<bool Difference>
+        double AccumulateCompensated(const float *a, const float *b, size_t count)
+        {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            __m128 compensation0 = _mm_setzero_ps();
+            __m128 compensation1 = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                CompensatedAdd(sum1,
+                    compensation1,
+                    Terms<Difference>(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+
+            // Zero padding adds nothing to either term
+            if (i < count)
+            {
+                alignas(16) float tailA[8] = {};
+                alignas(16) float tailB[8] = {};
+                for (size_t j = 0; i + j < count; ++j)
+                {
+                    tailA[j] = a[i + j];
+                    tailB[j] = b[i + j];
+                }
+                CompensatedAdd(sum0, compensation0, Terms<Difference>(_mm_load_ps(tailA), _mm_load_ps(tailB)));
+                CompensatedAdd(sum1, compensation1, Terms<Difference>(_mm_load_ps(tailA + 4), _mm_load_ps(tailB + 4)));
+            }
+
+            return CompensatedTotal(sum0, compensation0) + CompensatedTotal(sum1, compensation1);
+        }
+
+        double DotProductDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumDouble(const float *a, const float *b, size_t count)
+        {
+            return AccumulateDouble<true>(a, b, count);
+        }
+
+        double SumOfSquaresDouble(const float *a, size_t count)
+        {
+            return AccumulateDouble<false>(a, a, count);
+        }
+
+        double DotProductCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<false>(a, b, count);
+        }
+
+        double SquaredDifferenceSumCompensated(const float *a, const float *b, size_t count)
+        {
+            return AccumulateCompensated<true>(a, b, count);
+        }
+
+        double SumOfSquaresCompensated(const float *a, size_t count)
+        {
+            return AccumulateCompensated<false>(a, a, count);
+        }
+
+        constexpr KernelTable SSE2_KERNELS = {
+            IsaLevel::Sse2,
+            DotProduct,
+            SquaredDifferenceSum,
+            SumOfSquares,
+            ComplexMagnitude,
+            Sum,
+            Maximum,
+            DotProductDouble,
+            SquaredDifferenceSumDouble,
+            SumOfSquaresDouble,
+            DotProductCompensated,
+            SquaredDifferenceSumCompensated,
+            SumOfSquaresCompensated,
+        };
+    } // namespace
+
+    const KernelTable &GetSse2Kernels()
+    {
+        return SSE2_KERNELS;
+    }
+
+} // namespace GuitarDSP::Kernels
@@ -0,0 +1,322 @@
+// Replay of a production input capture.
+//
+// Loads a dump written by CaptureBuffer::Dump() and re-runs every frame
+// whose input is still in the captured history through a detector, in
+// stream order, timing each call the same way as guitar-dsp-wcet. Prints
+// the replay latency distribution, the slowest recorded frames next to
+// their replayed timings, and frames whose replayed result differs from
+// the recorded one. With GUITAR_DSP_ENABLE_PROFILING the per-stage
+// breakdown of the replay is shown as well.
+//
+// Usage: guitar-dsp-capture-replay <capture> [--detector yin|mpm|hybrid] [--iterations <n>]
+//        [--top <n>] [--threshold <value>] [--min-frequency <hz>] [--max-frequency <hz>]
+
+#include "CaptureBuffer.h"
+#include "CpuFeatures.h"
+#include "CycleCalibration.h"
+#include "HybridPitchDetector.h"
+#include "MpmPitchDetector.h"
+#include "StageProfiler.h"
+#include "YinPitchDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace GuitarDSP;
+
+namespace
+{
+    /**
+     * @brief Replay settings
+     */
+    struct Settings
+    {
+        std::string capturePath;         ///< Dump to replay
+        std::string detector = "hybrid"; ///< yin, mpm or hybrid
+        size_t iterations = 5;           ///< Timed runs per frame (minimum is reported)
+        size_t top = 10;                 ///< Slowest recorded frames listed
+        float threshold = 0.0f;          ///< Detector threshold (0 = detector default)
+        float minFrequency = 0.0f;       ///< Minimum frequency (0 = detector default)
+        float maxFrequency = 0.0f;       ///< Maximum frequency (0 = detector default)
+    };
+
+    /**
+     * @brief Replay outcome of one recorded frame
+     */
+    struct ReplayedFrame
+    {
+        const CaptureFrameRecord *record;  ///< Recorded frame
+        uint64_t minCycles;                ///< Fastest replay
+        uint64_t maxCycles;                ///< Slowest replay
+        std::optional<PitchResult> result; ///< Replayed result
+    };
+
+    constexpr float MISMATCH_CENTS = 5.0f; ///< Recorded and replayed pitch differ by more than this
+
+    bool ParseSettings(int argc, char **argv, Settings &settings)
+    {
+        if (argc < 2)
+        {
+            return false;
+        }
+
+        settings.capturePath = argv[1];
+        for (int i = 2; i + 1 < argc; i += 2)
+        {
+            const char *value = argv[i + 1];
+            if (std::strcmp(argv[i], "--detector") == 0)
+            {
+                settings.detector = value;
+            }
+            else if (std::strcmp(argv[i], "--iterations") == 0)
+            {
+                settings.iterations = std::strtoul(value, nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--top") == 0)
+            {
+                settings.top = std::strtoul(value, nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--threshold") == 0)
+            {
+                settings.threshold = static_cast<float>(std::atof(value));
+            }
+            else if (std::strcmp(argv[i], "--min-frequency") == 0)
+            {
+                settings.minFrequency = static_cast<float>(std::atof(value));
+            }
+            else if (std::strcmp(argv[i], "--max-frequency") == 0)
+            {
+                settings.maxFrequency = static_cast<float>(std::atof(value));
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return (argc % 2) == 0 && settings.iterations > 0
+               && (settings.detector == "yin" || settings.detector == "mpm" || settings.detector == "hybrid");
+    }
+
+    template<typename Config>
+    void ApplyOverrides(Config &config, const Settings &settings, size_t maxFrameSize)
+    {
+        config.maxBufferSize = std::max(config.maxBufferSize, maxFrameSize);
+        if (settings.threshold > 0.0f)
+        {
+            config.threshold = settings.threshold;
+        }
+        if (settings.minFrequency > 0.0f)
+        {
+            config.minFrequency = settings.minFrequency;
+        }
+        if (settings.maxFrequency > 0.0f)
+        {
+            config.maxFrequency = settings.maxFrequency;
+        }
+    }
+
+    std::unique_ptr<PitchDetector> MakeDetector(const Settings &settings, size_t maxFrameSize)
+    {
+        if (settings.detector == "yin")
+        {
+            YinPitchDetectorConfig config;
+            ApplyOverrides(config, settings, maxFrameSize);
+            return std::make_unique<YinPitchDetector>(config);
+        }
+
+        if (settings.detector == "mpm")
+        {
+            MpmPitchDetectorConfig config;
+            ApplyOverrides(config, settings, maxFrameSize);
+            return std::make_unique<MpmPitchDetector>(config);
+        }
+
+        HybridPitchDetectorConfig config;
+        ApplyOverrides(config.yinConfig, settings, maxFrameSize);
+        ApplyOverrides(config.mpmConfig, settings, maxFrameSize);
+        config.mpmConfig.threshold = MpmPitchDetectorConfig{}.threshold; // --threshold is the YIN threshold here
+        return std::make_unique<HybridPitchDetector>(config);
+    }
+
+    double ToMilliseconds(double cycles, double cyclesPerSecond)
+    {
+        return 1000.0 * cycles / cyclesPerSecond;
+    }
+
+    bool ResultsDiffer(const CaptureFrameRecord &record, const std::optional<PitchResult> &replayed)
+    {
+        if (record.valid != replayed.has_value())
+        {
+            return true;
+        }
+
+        if (!record.valid || record.result.frequency <= 0.0f || replayed->frequency <= 0.0f)
+        {
+            return false;
+        }
+
+        return std::abs(1200.0f * std::log2(replayed->frequency / record.result.frequency)) > MISMATCH_CENTS;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Settings settings;
+    if (!ParseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr,
+            "usage: %s <capture> [--detector yin|mpm|hybrid] [--iterations <n>] [--top <n>]\n"
+            "       [--threshold <value>] [--min-frequency <hz>] [--max-frequency <hz>]\n",
+            argv[0]);
+        return 2;
+    }
+
+    std::ifstream file(settings.capturePath, std::ios::binary);
+    const auto snapshot = CaptureBuffer::Load(file);
+    if (!snapshot)
+    {
+        std::fprintf(stderr, "%s: not a valid capture\n", settings.capturePath.c_str());
+        return 2;
+    }
+
+    size_t maxFrameSize = 0;
+    for (const auto &record : snapshot->frames)
+    {
+        maxFrameSize = std::max<size_t>(maxFrameSize, record.frameSize);
+    }
+
+    const double cyclesPerSecond = Tools::CalibrateCycleRate();
+    const auto detector = MakeDetector(settings, maxFrameSize);
+
+    StageProfiler profiler;
+    std::vector<ReplayedFrame> replayed;
+    std::vector<uint64_t> callCycles;
+    replayed.reserve(snapshot->frames.size());
+    callCycles.reserve(snapshot->frames.size());
+    volatile float sink = 0.0f;
+
+    // Stream order, so detectors with history see the same sequence as in the field
+    for (const auto &record : snapshot->frames)
+    {
+        const auto frame = snapshot->GetFrameSamples(record);
+        if (frame.empty())
+        {
+            continue;
+        }
+
+        ReplayedFrame outcome{ &record, UINT64_MAX, 0, std::nullopt };
+        for (size_t iteration = 0; iteration < settings.iterations; ++iteration)
+        {
+            StageProfiler::SetActive(iteration == 0 ? &profiler : nullptr);
+            const uint64_t start = StageProfiler::ReadCycleCounter();
+            const auto result = detector->Detect(frame, snapshot->sampleRate);
+            const uint64_t cycles = StageProfiler::ReadCycleCounter() - start;
+
+            outcome.minCycles = std::min(outcome.minCycles, cycles);
+            outcome.maxCycles = std::max(outcome.maxCycles, cycles);
+            if (iteration == 0)
+            {
+                outcome.result = result;
+            }
+            sink = result.value_or(PitchResult{ 0.0f, 0.0f }).frequency;
+        }
+        StageProfiler::SetActive(nullptr);
+
+        callCycles.push_back(outcome.minCycles);
+        replayed.push_back(outcome);
+    }
+    (void)sink;
+
+    std::printf("capture: %s, %.0f Hz, %zu samples (%.2f s) from stream sample %llu\n",
+        settings.capturePath.c_str(), snapshot->sampleRate, snapshot->samples.size(),
+        static_cast<double>(snapshot->samples.size()) / snapshot->sampleRate,
+        static_cast<unsigned long long>(snapshot->firstSample));
+    std::printf("frames: %zu recorded, %zu replayable, detector: %s, kernels: %s, cycle counter: %.1f MHz\n\n",
+        snapshot->frames.size(), replayed.size(), settings.detector.c_str(),
+        CpuFeatures::GetLevelName(CpuFeatures::GetActiveLevel()), cyclesPerSecond / 1e6);
+
+    if (replayed.empty())
+    {
+        std::printf("nothing to replay: no recorded frame is fully inside the captured history\n");
+        return 1;
+    }
+
+    const auto stats = StageProfiler::ComputeStatistics(callCycles);
+    std::printf("replay latency   p50 %.4f ms  p99 %.4f ms  p99.9 %.4f ms  max %.4f ms\n\n",
+        ToMilliseconds(static_cast<double>(stats.p50), cyclesPerSecond),
+        ToMilliseconds(static_cast<double>(stats.p99), cyclesPerSecond),
+        ToMilliseconds(static_cast<double>(stats.p999), cyclesPerSecond),
+        ToMilliseconds(static_cast<double>(stats.max), cyclesPerSecond));
+
+    // Slowest frames as recorded in the field (ticks of the capturing machine)
+    std::vector<const ReplayedFrame *> slowest;
+    for (const auto &outcome : replayed)
+    {
+        slowest.push_back(&outcome);
+    }
+    std::sort(slowest.begin(), slowest.end(), [](const ReplayedFrame *a, const ReplayedFrame *b) {
+        return a->record->cycles > b->record->cycles;
+    });
+    slowest.resize(std::min(slowest.size(), settings.top));
+
+    std::printf("%-12s %-10s %14s %12s %12s %10s %10s\n", "time s", "stream", "recorded tick", "replay min",
+        "replay max", "rec Hz", "replay Hz");
+    for (const auto *outcome : slowest)
+    {
+        const auto &record = *outcome->record;
+        std::printf("%-12.4f %-10llu %14llu %9.4f ms %9.4f ms %10.2f %10.2f\n",
+            static_cast<double>(record.frameStart) / snapshot->sampleRate,
+            static_cast<unsigned long long>(record.frameStart), static_cast<unsigned long long>(record.cycles),
+            ToMilliseconds(static_cast<double>(outcome->minCycles), cyclesPerSecond),
+            ToMilliseconds(static_cast<double>(outcome->maxCycles), cyclesPerSecond),
+            record.valid ? record.result.frequency : 0.0f, outcome->result ? outcome->result->frequency : 0.0f);
+    }
+
+    size_t mismatches = 0;
+    for (const auto &outcome : replayed)
+    {
+        if (!ResultsDiffer(*outcome.record, outcome.result))
+        {
+            continue;
+        }
+
+        if (mismatches++ == 0)
+        {
+            std::printf("\nresult mismatches (> %.0f cents or detection differs):\n", MISMATCH_CENTS);
+        }
+        std::printf("  stream %llu: recorded %.2f Hz (%s), replayed %.2f Hz (%s)\n",
+            static_cast<unsigned long long>(outcome.record->frameStart), outcome.record->result.frequency,
+            outcome.record->valid ? "valid" : "none", outcome.result ? outcome.result->frequency : 0.0f,
+            outcome.result ? "valid" : "none");
+    }
+    std::printf("\n%zu of %zu replayed frames differ from the recording\n", mismatches, replayed.size());
+
+#if defined(GUITAR_DSP_PROFILING)
+    std::printf("\nstage breakdown over first replay of every frame:\n");
+    for (size_t stage = 0; stage < static_cast<size_t>(ProfileStage::Count); ++stage)
+    {
+        const auto profileStage = static_cast<ProfileStage>(stage);
+        const auto stageStats = profiler.ComputeStatistics(profileStage);
+        if (stageStats.count == 0)
+        {
+            continue;
+        }
+
+        std::printf("  %-38s p50 %.4f ms  max %.4f ms  n=%zu\n", StageProfiler::GetStageName(profileStage),
+            ToMilliseconds(static_cast<double>(stageStats.p50), cyclesPerSecond),
+            ToMilliseconds(static_cast<double>(stageStats.max), cyclesPerSecond), stageStats.count);
+    }
+#else
+    std::printf("\nstage breakdown unavailable: configure with -DGUITAR_DSP_ENABLE_PROFILING=ON\n");
+#endif
+
+    return 0;
+}
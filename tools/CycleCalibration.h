@@ -0,0 +1,29 @@
+#pragma once
+
+#include "StageProfiler.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace GuitarDSP::Tools
+{
+    /**
+     * @brief Measures cycle counter ticks per second against steady_clock
+     *
+     * Spins for about 200 ms; call once before timing, outside measured scopes.
+     */
+    inline double CalibrateCycleRate()
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto wallStart = Clock::now();
+        const uint64_t cycleStart = StageProfiler::ReadCycleCounter();
+
+        while (Clock::now() - wallStart < std::chrono::milliseconds(200))
+        {
+        }
+
+        const uint64_t cycles = StageProfiler::ReadCycleCounter() - cycleStart;
+        const double seconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+        return static_cast<double>(cycles) / seconds;
+    }
+} // namespace GuitarDSP::Tools
@@ -0,0 +1,117 @@
+// Profile-guided optimisation training workload.
+//
+// Run by the pgo-train target on a library configured with
+// GUITAR_DSP_PGO=GENERATE. Drives the detectors, stabilizers, FFT and
+// inharmonicity estimator over synthetic guitar signals so the recorded
+// profile reflects a tuner's steady state: plucked notes across the neck,
+// decays into silence, noise between notes and the occasional sweep.
+
+#include "FFTProcessor.h"
+#include "HybridPitchDetector.h"
+#include "InharmonicityEstimator.h"
+#include "MpmPitchDetector.h"
+#include "PitchStabilizer.h"
+#include "SyntheticSignals.h"
+#include "YinPitchDetector.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace GuitarDSP;
+using GuitarDSP::Tools::SyntheticSignals;
+
+namespace
+{
+    constexpr float SAMPLE_RATE = 48000.0f;
+    constexpr size_t FRAME_SIZE = 4096;
+    constexpr size_t HOP_SIZE = 512;
+    constexpr size_t HOPS_PER_NOTE = 24;
+    constexpr size_t SPECTRUM_INTERVAL = 4; // Spectral analysis runs every few hops, as in a tuner UI
+
+    // Open strings of standard tuning (E2 A2 D3 G3 B3 E4)
+    constexpr std::array<float, 6> OPEN_STRINGS = { 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f };
+    constexpr int FRETS = 12;
+} // namespace
+
+int main()
+{
+    YinPitchDetector yin;
+    MpmPitchDetector mpm;
+    HybridPitchDetector hybrid;
+    HybridStabilizer stabilizer;
+    FFTProcessor fft(FRAME_SIZE, SAMPLE_RATE);
+    InharmonicityEstimator inharmonicity;
+
+    YinPitchDetectorConfig yinDoubleConfig;
+    yinDoubleConfig.precision = AccumulationPrecision::Double;
+    YinPitchDetector yinDouble(yinDoubleConfig);
+    MpmPitchDetectorConfig mpmCompensatedConfig;
+    mpmCompensatedConfig.precision = AccumulationPrecision::Compensated;
+    MpmPitchDetector mpmCompensated(mpmCompensatedConfig);
+
+    std::vector<float> frame(FRAME_SIZE, 0.0f);
+    size_t frames = 0;
+    double checksum = 0.0;
+
+    auto analyse = [&](std::span<const float> buffer, bool allPrecisions) {
+        const auto hybridResult = hybrid.Detect(buffer, SAMPLE_RATE);
+        const auto yinResult = yin.Detect(buffer, SAMPLE_RATE);
+        const auto mpmResult = mpm.Detect(buffer, SAMPLE_RATE);
+        if (allPrecisions)
+        {
+            checksum += yinDouble.Detect(buffer, SAMPLE_RATE).value_or(PitchResult{}).frequency;
+            checksum += mpmCompensated.Detect(buffer, SAMPLE_RATE).value_or(PitchResult{}).frequency;
+        }
+
+        stabilizer.Update(hybridResult.value_or(PitchResult{ 0.0f, 0.0f }));
+        checksum += stabilizer.GetStabilized().frequency;
+        checksum += yinResult.value_or(PitchResult{}).frequency + mpmResult.value_or(PitchResult{}).frequency;
+
+        if (frames++ % SPECTRUM_INTERVAL != 0)
+        {
+            return;
+        }
+
+        fft.ComputeSpectrum(buffer);
+        if (hybridResult.has_value())
+        {
+            if (const auto estimate = inharmonicity.Estimate(fft.GetSpectrum(), hybridResult->frequency))
+            {
+                checksum += estimate->inharmonicity;
+            }
+        }
+    };
+
+    // Plucked notes over the first twelve frets of every string
+    for (size_t string = 0; string < OPEN_STRINGS.size(); ++string)
+    {
+        for (int fret = 0; fret <= FRETS; ++fret)
+        {
+            const float frequency = OPEN_STRINGS[string] * std::pow(2.0f, static_cast<float>(fret) / 12.0f);
+            const float inharmonicity = 5e-5f * static_cast<float>(string + 1);
+            stabilizer.Reset();
+
+            for (size_t hop = 0; hop < HOPS_PER_NOTE; ++hop)
+            {
+                SyntheticSignals::GuitarPluck(frame, frequency, SAMPLE_RATE, inharmonicity, hop * HOP_SIZE);
+                analyse(frame, fret % 4 == 0);
+            }
+        }
+    }
+
+    // Silence, noise floor and sweeps between notes
+    for (size_t hop = 0; hop < HOPS_PER_NOTE; ++hop)
+    {
+        SyntheticSignals::Constant(frame);
+        analyse(frame, false);
+        SyntheticSignals::Noise(frame, static_cast<uint32_t>(hop + 1), 0.01f);
+        analyse(frame, false);
+        SyntheticSignals::Sweep(frame, 70.0f + static_cast<float>(hop) * 20.0f, 1200.0f, SAMPLE_RATE);
+        analyse(frame, false);
+    }
+
+    std::printf("pgo training: %zu frames (checksum %.3f)\n", frames, checksum);
+    return 0;
+}
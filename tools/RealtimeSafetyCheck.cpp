@@ -0,0 +1,547 @@
+// Real-time safety verification for the audio-thread API.
+//
+// Interposes heap allocation and blocking primitives, then drives every
+// detector, stabilizer, spectral analysis and streaming component documented
+// as real-time safe through typical and edge-case buffers. Any allocation,
+// free or blocking call made while a component is processing is reported
+// and the tool exits with a non-zero status.
+
+#include "BandLimitFilter.h"
+#include "CaptureBuffer.h"
+#include "FFTProcessor.h"
+#include "HybridPitchDetector.h"
+#include "InharmonicityEstimator.h"
+#include "KernelDispatch.h"
+#include "MpmPitchDetector.h"
+#include "PitchStabilizer.h"
+#include "PitchToMidi.h"
+#include "ProgressivePitchDetector.h"
+#include "ResonatorBank.h"
+#include "SpectralAnalysisHub.h"
+#include "SpectrogramHistory.h"
+#include "SpectrumBandReducer.h"
+#include "SpectrumPublisher.h"
+#include "SyntheticSignals.h"
+#include "YinPitchDetector.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#include <semaphore.h>
+#define GUITAR_DSP_INTERPOSE_LIBC 1
+#endif
+
+namespace
+{
+    thread_local bool guardActive = false;
+
+    std::atomic<size_t> allocationCount{ 0 };
+    std::atomic<size_t> deallocationCount{ 0 };
+    std::atomic<size_t> blockingCount{ 0 };
+
+    void RecordAllocation()
+    {
+        if (guardActive)
+        {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void RecordDeallocation()
+    {
+        if (guardActive)
+        {
+            deallocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    [[maybe_unused]] void RecordBlocking()
+    {
+        if (guardActive)
+        {
+            blockingCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Marks the calling thread as running hot-path code
+     */
+    class RealtimeScope
+    {
+    public:
+        RealtimeScope()
+        {
+            guardActive = true;
+        }
+
+        ~RealtimeScope()
+        {
+            guardActive = false;
+        }
+
+        RealtimeScope(const RealtimeScope &) = delete;
+        RealtimeScope &operator=(const RealtimeScope &) = delete;
+    };
+
+    void *Allocate(std::size_t size)
+    {
+#if !defined(GUITAR_DSP_INTERPOSE_LIBC)
+        // Without libc interposition count at the C++ level
+        RecordAllocation();
+#endif
+        if (void *memory = std::malloc(size == 0 ? 1 : size))
+        {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void Deallocate(void *memory) noexcept
+    {
+#if !defined(GUITAR_DSP_INTERPOSE_LIBC)
+        if (memory != nullptr)
+        {
+            RecordDeallocation();
+        }
+#endif
+        std::free(memory);
+    }
+} // namespace
+
+// Replaceable global allocation functions
+void *operator new(std::size_t size)
+{
+    return Allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return Allocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *memory) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    Deallocate(memory);
+}
+
+#if defined(GUITAR_DSP_INTERPOSE_LIBC)
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *memory, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *memory);
+
+    void *malloc(size_t size)
+    {
+        RecordAllocation();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        RecordAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *memory, size_t size)
+    {
+        RecordAllocation();
+        return __libc_realloc(memory, size);
+    }
+
+    void *aligned_alloc(size_t alignment, size_t size)
+    {
+        RecordAllocation();
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void **memory, size_t alignment, size_t size)
+    {
+        RecordAllocation();
+        *memory = __libc_memalign(alignment, size);
+        return *memory != nullptr ? 0 : 12; // ENOMEM
+    }
+
+    void free(void *memory)
+    {
+        if (memory != nullptr)
+        {
+            RecordDeallocation();
+        }
+        __libc_free(memory);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t *mutex)
+    {
+        using Function = int (*)(pthread_mutex_t *);
+        static const auto real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        RecordBlocking();
+        return real(mutex);
+    }
+
+    int pthread_cond_wait(pthread_cond_t *condition, pthread_mutex_t *mutex)
+    {
+        using Function = int (*)(pthread_cond_t *, pthread_mutex_t *);
+        static const auto real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "pthread_cond_wait"));
+        RecordBlocking();
+        return real(condition, mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t *lock)
+    {
+        using Function = int (*)(pthread_rwlock_t *);
+        static const auto real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "pthread_rwlock_rdlock"));
+        RecordBlocking();
+        return real(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t *lock)
+    {
+        using Function = int (*)(pthread_rwlock_t *);
+        static const auto real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "pthread_rwlock_wrlock"));
+        RecordBlocking();
+        return real(lock);
+    }
+
+    int sem_wait(sem_t *semaphore)
+    {
+        using Function = int (*)(sem_t *);
+        static const auto real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, "sem_wait"));
+        RecordBlocking();
+        return real(semaphore);
+    }
+}
+#endif
+
+namespace
+{
+    using namespace GuitarDSP;
+    using Tools::SyntheticSignals;
+
+    constexpr float SAMPLE_RATE = 48000.0f;
+    constexpr size_t FRAME_SIZE = 4096;
+    constexpr size_t MAX_INPUT_SIZE = 4 * FRAME_SIZE; ///< Largest input case (oversized buffer)
+    constexpr size_t STREAM_BLOCK_SIZE = 256;         ///< Block size for incremental Push/Refine
+
+    /**
+     * @brief Named input buffer
+     */
+    struct InputCase
+    {
+        std::string name;          ///< Case description
+        std::vector<float> buffer; ///< Input samples
+    };
+
+    /**
+     * @brief Named hot-path operation
+     */
+    struct Component
+    {
+        std::string name;                                   ///< Component description
+        std::function<void(std::span<const float>)> process; ///< Hot-path call under test
+    };
+
+    std::vector<InputCase> MakeInputCases()
+    {
+        std::vector<InputCase> cases;
+
+        auto add = [&cases](const std::string &name, size_t size, const auto &generate) {
+            InputCase input{ name, std::vector<float>(size, 0.0f) };
+            generate(std::span<float>(input.buffer));
+            cases.push_back(std::move(input));
+        };
+
+        add("sine 82 Hz", FRAME_SIZE, [](std::span<float> out) { SyntheticSignals::Sine(out, 82.41f, SAMPLE_RATE); });
+        add("sine 440 Hz", FRAME_SIZE, [](std::span<float> out) { SyntheticSignals::Sine(out, 440.0f, SAMPLE_RATE); });
+        add("pluck 110 Hz", FRAME_SIZE, [](std::span<float> out) {
+            SyntheticSignals::GuitarPluck(out, 110.0f, SAMPLE_RATE);
+        });
+        add("square 196 Hz", FRAME_SIZE, [](std::span<float> out) {
+            SyntheticSignals::Square(out, 196.0f, SAMPLE_RATE);
+        });
+        add("sweep", FRAME_SIZE, [](std::span<float> out) {
+            SyntheticSignals::Sweep(out, 80.0f, 1200.0f, SAMPLE_RATE);
+        });
+        add("noise", FRAME_SIZE, [](std::span<float> out) { SyntheticSignals::Noise(out); });
+        add("silence", FRAME_SIZE, [](std::span<float> out) { SyntheticSignals::Constant(out); });
+        add("dc offset", FRAME_SIZE, [](std::span<float> out) { SyntheticSignals::Constant(out, 0.25f); });
+        add("denormal level", FRAME_SIZE, [](std::span<float> out) {
+            SyntheticSignals::Sine(out, 220.0f, SAMPLE_RATE, 1e-38f);
+        });
+        add("short buffer", 256, [](std::span<float> out) { SyntheticSignals::Sine(out, 440.0f, SAMPLE_RATE); });
+        add("oversized buffer", MAX_INPUT_SIZE, [](std::span<float> out) {
+            SyntheticSignals::Sine(out, 110.0f, SAMPLE_RATE);
+        });
+        add("empty buffer", 0, [](std::span<float>) {});
+
+        return cases;
+    }
+
+    /**
+     * @brief Spectrum consumer that reads every dispatched frame
+     */
+    class MagnitudeProbe : public SpectrumConsumer
+    {
+    public:
+        void OnSpectrum(const SpectrumFrame &frame) override
+        {
+            if (!frame.magnitudes.empty())
+            {
+                peak = *std::max_element(frame.magnitudes.begin(), frame.magnitudes.end());
+            }
+        }
+
+        float peak = 0.0f; ///< Largest magnitude of the last frame
+    };
+} // namespace
+
+int main()
+{
+    const auto inputCases = MakeInputCases();
+
+    // Construction happens outside the checked scope
+    YinPitchDetector yin;
+    YinPitchDetectorConfig yinDoubleConfig;
+    yinDoubleConfig.precision = AccumulationPrecision::Double;
+    YinPitchDetector yinDouble(yinDoubleConfig);
+    YinPitchDetectorConfig yinLazyConfig;
+    yinLazyConfig.lazyEvaluation = true;
+    YinPitchDetector yinLazy(yinLazyConfig);
+    YinPitchDetectorConfig yinAdaptiveConfig;
+    yinAdaptiveConfig.adaptivePeriods = 4.0f;
+    YinPitchDetector yinAdaptive(yinAdaptiveConfig);
+    MpmPitchDetector mpm;
+    MpmPitchDetectorConfig mpmCompensatedConfig;
+    mpmCompensatedConfig.precision = AccumulationPrecision::Compensated;
+    MpmPitchDetector mpmCompensated(mpmCompensatedConfig);
+    MpmPitchDetectorConfig mpmLazyConfig;
+    mpmLazyConfig.lazyEvaluation = true;
+    MpmPitchDetector mpmLazy(mpmLazyConfig);
+    HybridPitchDetector hybrid;
+    ExponentialMovingAverage ema;
+    MedianFilter median;
+    HybridStabilizer hybridStabilizer;
+    FFTProcessor fft(FRAME_SIZE, SAMPLE_RATE);
+    InharmonicityEstimator inharmonicity;
+    PitchToMidi pitchToMidi;
+    std::array<MidiEvent, 64> midiEvents{};
+    ProgressivePitchDetector progressive;
+    ResonatorBank resonators;
+    BandLimitFilter bandLimit;
+    std::vector<float> filtered(MAX_INPUT_SIZE, 0.0f);
+    SpectralAnalysisHub hub;
+    MagnitudeProbe probe;
+    hub.AddConsumer(&probe);
+    SpectrumPublisher publisher(FRAME_SIZE, SAMPLE_RATE);
+    std::vector<float> magnitudes(FRAME_SIZE / 2, 0.0f);
+    SpectrumBandReducerConfig reducerConfig;
+    reducerConfig.fftSize = FRAME_SIZE;
+    SpectrumBandReducer reducer(reducerConfig);
+    DisplayBands displayBands;
+    SpectrogramHistoryConfig spectrogramConfig;
+    spectrogramConfig.binCount = FRAME_SIZE / 2;
+    spectrogramConfig.capacity = 256;
+    SpectrogramHistory spectrogram(spectrogramConfig);
+    SpectrogramHistoryConfig logSpectrogramConfig = spectrogramConfig;
+    logSpectrogramConfig.logFrequency = true;
+    SpectrogramHistory logSpectrogram(logSpectrogramConfig);
+    CaptureBuffer capture;
+
+    volatile float sink = 0.0f;
+
+    auto detect = [&sink](PitchDetector &detector, std::span<const float> buffer) {
+        if (auto result = detector.Detect(buffer, SAMPLE_RATE))
+        {
+            sink = result->frequency;
+        }
+    };
+
+    auto stabilize = [&sink, &yin](PitchStabilizer &stabilizer, std::span<const float> buffer) {
+        const auto detected = yin.Detect(buffer, SAMPLE_RATE);
+        for (int i = 0; i < 16; ++i)
+        {
+            stabilizer.Update(detected.value_or(PitchResult{ 110.0f + static_cast<float>(i), 0.5f }));
+            sink = stabilizer.GetStabilized().frequency;
+        }
+    };
+
+    // Magnitudes of a buffer for the components that consume them
+    auto transform = [&fft, &magnitudes](std::span<const float> buffer) {
+        fft.ComputeSpectrum(buffer);
+        GetKernels().complexMagnitude(fft.GetSpectrum().data.data(), magnitudes.data(), magnitudes.size());
+    };
+
+    const std::vector<Component> components = {
+        { "YinPitchDetector", [&](std::span<const float> buffer) { detect(yin, buffer); } },
+        { "YinPitchDetector (double)", [&](std::span<const float> buffer) { detect(yinDouble, buffer); } },
+        { "YinPitchDetector (lazy)", [&](std::span<const float> buffer) { detect(yinLazy, buffer); } },
+        { "YinPitchDetector (adaptive)", [&](std::span<const float> buffer) { detect(yinAdaptive, buffer); } },
+        { "MpmPitchDetector", [&](std::span<const float> buffer) { detect(mpm, buffer); } },
+        { "MpmPitchDetector (compensated)", [&](std::span<const float> buffer) { detect(mpmCompensated, buffer); } },
+        { "MpmPitchDetector (lazy)", [&](std::span<const float> buffer) { detect(mpmLazy, buffer); } },
+        { "HybridPitchDetector", [&](std::span<const float> buffer) { detect(hybrid, buffer); } },
+        { "ExponentialMovingAverage", [&](std::span<const float> buffer) { stabilize(ema, buffer); } },
+        { "MedianFilter", [&](std::span<const float> buffer) { stabilize(median, buffer); } },
+        { "HybridStabilizer", [&](std::span<const float> buffer) { stabilize(hybridStabilizer, buffer); } },
+        { "FFTProcessor", [&](std::span<const float> buffer) {
+             fft.ComputeSpectrum(buffer);
+             sink = fft.GetSpectrum().GetMagnitudeAtFrequency(440.0f);
+         } },
+        { "InharmonicityEstimator", [&](std::span<const float> buffer) {
+             fft.ComputeSpectrum(buffer);
+             if (auto result = inharmonicity.Estimate(fft.GetSpectrum(), 110.0f))
+             {
+                 sink = result->fundamental;
+             }
+         } },
+        { "PitchToMidi", [&](std::span<const float> buffer) {
+             pitchToMidi.Process(buffer);
+             sink = static_cast<float>(pitchToMidi.GetEvents().Drain(midiEvents));
+         } },
+        { "ProgressivePitchDetector (Push/Refine)", [&](std::span<const float> buffer) {
+             progressive.Reset();
+             for (size_t offset = 0; offset < buffer.size(); offset += STREAM_BLOCK_SIZE)
+             {
+                 progressive.Push(buffer.subspan(offset, std::min(STREAM_BLOCK_SIZE, buffer.size() - offset)));
+                 if (auto result = progressive.Refine(SAMPLE_RATE))
+                 {
+                     sink = result->frequency;
+                 }
+             }
+         } },
+        { "ResonatorBank", [&](std::span<const float> buffer) {
+             resonators.Process(buffer);
+             sink = resonators.GetReadings().front().magnitude;
+         } },
+        { "BandLimitFilter", [&](std::span<const float> buffer) {
+             bandLimit.Process(buffer, std::span<float>(filtered).first(buffer.size()));
+             sink = buffer.empty() ? 0.0f : filtered[buffer.size() - 1];
+         } },
+        { "SpectralAnalysisHub", [&](std::span<const float> buffer) {
+             hub.Push(buffer);
+             sink = probe.peak;
+         } },
+        { "SpectrumPublisher", [&](std::span<const float> buffer) {
+             if (buffer.size() >= FRAME_SIZE)
+             {
+                 publisher.Publish(fft, buffer);
+             }
+             else
+             {
+                 fft.ComputeSpectrum(buffer);
+                 publisher.Publish(fft.GetSpectrum());
+             }
+         } },
+        { "SpectrumBandReducer", [&](std::span<const float> buffer) {
+             transform(buffer);
+             reducer.Process(magnitudes, displayBands);
+             sink = displayBands.peakDb[0];
+         } },
+        { "SpectrogramHistory", [&](std::span<const float> buffer) {
+             transform(buffer);
+             spectrogram.Append(magnitudes);
+         } },
+        { "SpectrogramHistory (log frequency)", [&](std::span<const float> buffer) {
+             transform(buffer);
+             logSpectrogram.Append(magnitudes);
+         } },
+        { "CaptureBuffer", [&](std::span<const float> buffer) {
+             capture.Push(buffer);
+             capture.RecordFrame(capture.GetStreamPosition() - buffer.size(), buffer.size(), 0, PitchResult{});
+         } },
+    };
+
+    size_t failures = 0;
+
+    for (const auto &component : components)
+    {
+        for (const auto &input : inputCases)
+        {
+            const size_t allocationsBefore = allocationCount.load();
+            const size_t deallocationsBefore = deallocationCount.load();
+            const size_t blockingBefore = blockingCount.load();
+
+            {
+                RealtimeScope scope;
+                component.process(input.buffer);
+            }
+
+            const size_t allocations = allocationCount.load() - allocationsBefore;
+            const size_t deallocations = deallocationCount.load() - deallocationsBefore;
+            const size_t blocking = blockingCount.load() - blockingBefore;
+
+            if (allocations + deallocations + blocking > 0)
+            {
+                ++failures;
+                std::printf("FAIL  %-40s %-18s alloc=%zu free=%zu block=%zu\n",
+                    component.name.c_str(),
+                    input.name.c_str(),
+                    allocations,
+                    deallocations,
+                    blocking);
+            }
+        }
+    }
+
+#if !defined(GUITAR_DSP_INTERPOSE_LIBC)
+    std::printf("note: libc interposition unavailable, only C++ allocations and no locks are checked\n");
+#endif
+
+    std::printf("%zu components x %zu inputs checked, %zu violation(s)\n",
+        components.size(),
+        inputCases.size(),
+        failures);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
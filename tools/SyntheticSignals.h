@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+
+namespace GuitarDSP::Tools
+{
+    /**
+     * @brief Deterministic test signal generators for tools and benchmarks
+     *
+     * All generators write into caller-provided buffers so they can be used
+     * from allocation-checked scopes.
+     */
+    class SyntheticSignals
+    {
+    public:
+        /**
+         * @brief Writes pure sine
+         */
+        static void Sine(std::span<float> out, float frequency, float sampleRate, float amplitude = 0.5f)
+        {
+            const double step = 2.0 * std::numbers::pi * frequency / sampleRate;
+            for (size_t i = 0; i < out.size(); ++i)
+            {
+                out[i] = amplitude * static_cast<float>(std::sin(step * static_cast<double>(i)));
+            }
+        }
+
+        /**
+         * @brief Writes plucked-string tone with decaying, stretched partials
+         * @param inharmonicity Stiff-string coefficient B (0 = harmonic)
+         * @param offset Sample offset of out[0] from the pluck
+         */
+        static void GuitarPluck(std::span<float> out,
+            float frequency,
+            float sampleRate,
+            float inharmonicity = 1e-4f,
+            size_t offset = 0)
+        {
+            constexpr int partials = 12;
+            for (size_t i = 0; i < out.size(); ++i)
+            {
+                const double t = static_cast<double>(i + offset) / sampleRate;
+                double sample = 0.0;
+                for (int n = 1; n <= partials; ++n)
+                {
+                    const double partialFrequency =
+                        n * frequency * std::sqrt(1.0 + inharmonicity * static_cast<double>(n * n));
+                    if (partialFrequency >= sampleRate * 0.5)
+                    {
+                        break;
+                    }
+
+                    // Higher partials are weaker and decay faster
+                    const double amplitude = 0.6 / n * std::exp(-t * (1.5 + 0.8 * n));
+                    sample += amplitude * std::sin(2.0 * std::numbers::pi * partialFrequency * t);
+                }
+                out[i] = static_cast<float>(sample);
+            }
+        }
+
+        /**
+         * @brief Writes band-unlimited square wave
+         */
+        static void Square(std::span<float> out, float frequency, float sampleRate, float amplitude = 0.5f)
+        {
+            const double period = sampleRate / frequency;
+            for (size_t i = 0; i < out.size(); ++i)
+            {
+                const double phase = std::fmod(static_cast<double>(i), period) / period;
+                out[i] = phase < 0.5 ? amplitude : -amplitude;
+            }
+        }
+
+        /**
+         * @brief Writes exponential sine sweep
+         */
+        static void Sweep(std::span<float> out,
+            float startFrequency,
+            float endFrequency,
+            float sampleRate,
+            float amplitude = 0.5f)
+        {
+            const double duration = static_cast<double>(out.size()) / sampleRate;
+            const double rate = std::log(endFrequency / startFrequency) / duration;
+            for (size_t i = 0; i < out.size(); ++i)
+            {
+                const double t = static_cast<double>(i) / sampleRate;
+                const double phase = 2.0 * std::numbers::pi * startFrequency * (std::exp(rate * t) - 1.0) / rate;
+                out[i] = amplitude * static_cast<float>(std::sin(phase));
+            }
+        }
+
+        /**
+         * @brief Writes uniform white noise from a fixed-seed LCG
+         */
+        static void Noise(std::span<float> out, uint32_t seed = 1, float amplitude = 0.5f)
+        {
+            uint32_t state = seed;
+            for (auto &sample : out)
+            {
+                state = state * 1664525u + 1013904223u;
+                sample = amplitude * (static_cast<float>(state >> 8) / 8388608.0f - 1.0f);
+            }
+        }
+
+        /**
+         * @brief Writes constant value (silence by default)
+         */
+        static void Constant(std::span<float> out, float value = 0.0f)
+        {
+            for (auto &sample : out)
+            {
+                sample = value;
+            }
+        }
+    };
+
+} // namespace GuitarDSP::Tools
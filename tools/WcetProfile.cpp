@@ -0,0 +1,215 @@
+// Worst-case execution time profile of the pitch detectors.
+//
+// Drives each detector over adversarial inputs (noise, silence, square
+// waves, sweeps, denormals) and records the cycle count of every call. The
+// per-call distribution (p50/p99/p99.9/max) is reported against an audio
+// callback budget and the tool exits with a non-zero status if any call
+// exceeded it. When the library is built with GUITAR_DSP_ENABLE_PROFILING
+// the same run also reports the per-stage breakdown.
+//
+// Usage: guitar-dsp-wcet [--budget-ms <ms>] [--iterations <n>] [--frame <samples>]
+
+#include "CpuFeatures.h"
+#include "CycleCalibration.h"
+#include "HybridPitchDetector.h"
+#include "MpmPitchDetector.h"
+#include "StageProfiler.h"
+#include "SyntheticSignals.h"
+#include "YinPitchDetector.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace GuitarDSP;
+using GuitarDSP::Tools::SyntheticSignals;
+
+namespace
+{
+    constexpr float SAMPLE_RATE = 48000.0f;
+    constexpr size_t HOP_SIZE = 256;
+
+    /**
+     * @brief Profiling run settings
+     */
+    struct Settings
+    {
+        double budgetMilliseconds = 1000.0 * HOP_SIZE / SAMPLE_RATE; ///< Callback budget
+        size_t iterations = 2000;                                    ///< Calls per detector and input
+        size_t frameSize = 4096;                                     ///< Analysis window
+    };
+
+    /**
+     * @brief Named input signal
+     */
+    struct InputCase
+    {
+        std::string name;          ///< Display name
+        std::vector<float> signal; ///< Signal the frames are taken from
+    };
+
+    bool ParseSettings(int argc, char **argv, Settings &settings)
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const char *value = argv[i + 1];
+            if (std::strcmp(argv[i], "--budget-ms") == 0)
+            {
+                settings.budgetMilliseconds = std::atof(value);
+            }
+            else if (std::strcmp(argv[i], "--iterations") == 0)
+            {
+                settings.iterations = std::strtoul(value, nullptr, 10);
+            }
+            else if (std::strcmp(argv[i], "--frame") == 0)
+            {
+                settings.frameSize = std::strtoul(value, nullptr, 10);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return (argc % 2) == 1 && settings.budgetMilliseconds > 0.0 && settings.iterations > 0
+               && settings.frameSize > 0;
+    }
+
+    std::vector<InputCase> MakeInputCases(size_t length)
+    {
+        std::vector<InputCase> cases;
+        auto add = [&cases, length](const char *name, const std::function<void(std::span<float>)> &generate) {
+            InputCase input{ name, std::vector<float>(length, 0.0f) };
+            generate(input.signal);
+            cases.push_back(std::move(input));
+        };
+
+        add("white noise", [](std::span<float> out) { SyntheticSignals::Noise(out, 7); });
+        add("silence", [](std::span<float> out) { SyntheticSignals::Constant(out); });
+        add("square 82 Hz", [](std::span<float> out) { SyntheticSignals::Square(out, 82.41f, SAMPLE_RATE); });
+        add("square 1 kHz", [](std::span<float> out) { SyntheticSignals::Square(out, 1000.0f, SAMPLE_RATE); });
+        add("sweep 60-2000 Hz", [](std::span<float> out) {
+            SyntheticSignals::Sweep(out, 60.0f, 2000.0f, SAMPLE_RATE);
+        });
+        add("pluck E2", [](std::span<float> out) { SyntheticSignals::GuitarPluck(out, 82.41f, SAMPLE_RATE); });
+        add("denormal level", [](std::span<float> out) { SyntheticSignals::Sine(out, 220.0f, SAMPLE_RATE, 1e-38f); });
+
+        return cases;
+    }
+
+    double ToMilliseconds(double cycles, double cyclesPerSecond)
+    {
+        return 1000.0 * cycles / cyclesPerSecond;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Settings settings;
+    if (!ParseSettings(argc, argv, settings))
+    {
+        std::fprintf(stderr, "usage: %s [--budget-ms <ms>] [--iterations <n>] [--frame <samples>]\n", argv[0]);
+        return 2;
+    }
+
+    const double cyclesPerSecond = Tools::CalibrateCycleRate();
+    const auto inputCases = MakeInputCases(settings.frameSize + settings.iterations * HOP_SIZE);
+
+    YinPitchDetectorConfig yinConfig;
+    yinConfig.maxBufferSize = settings.frameSize;
+    MpmPitchDetectorConfig mpmConfig;
+    mpmConfig.maxBufferSize = settings.frameSize;
+    HybridPitchDetectorConfig hybridConfig;
+    hybridConfig.yinConfig.maxBufferSize = settings.frameSize;
+    hybridConfig.mpmConfig.maxBufferSize = settings.frameSize;
+
+    YinPitchDetector yin(yinConfig);
+    MpmPitchDetector mpm(mpmConfig);
+    HybridPitchDetector hybrid(hybridConfig);
+
+    struct Target
+    {
+        const char *name;
+        PitchDetector *detector;
+    };
+    const Target targets[] = { { "YinPitchDetector", &yin }, { "MpmPitchDetector", &mpm },
+                               { "HybridPitchDetector", &hybrid } };
+
+    StageProfilerConfig profilerConfig;
+    profilerConfig.maxSamplesPerStage = settings.iterations;
+    StageProfiler profiler(profilerConfig);
+    StageProfiler::SetActive(&profiler);
+
+    std::vector<uint64_t> callCycles(settings.iterations, 0);
+    volatile float sink = 0.0f;
+    bool overBudget = false;
+
+    std::printf("cycle counter: %.1f MHz, kernels: %s\n", cyclesPerSecond / 1e6,
+                CpuFeatures::GetLevelName(CpuFeatures::GetActiveLevel()));
+    std::printf("callback budget: %.3f ms (%zu-sample frames, %zu calls per case)\n\n",
+                settings.budgetMilliseconds, settings.frameSize, settings.iterations);
+    std::printf("%-22s %-18s %10s %10s %10s %10s %8s\n", "detector", "input", "p50 ms", "p99 ms", "p99.9 ms",
+                "max ms", "budget");
+
+    for (const auto &target : targets)
+    {
+        for (const auto &input : inputCases)
+        {
+            target.detector->Reset();
+            profiler.Reset();
+
+            for (size_t call = 0; call < settings.iterations; ++call)
+            {
+                const auto frame = std::span<const float>(input.signal).subspan(call * HOP_SIZE, settings.frameSize);
+                const uint64_t start = StageProfiler::ReadCycleCounter();
+                const auto result = target.detector->Detect(frame, SAMPLE_RATE);
+                callCycles[call] = StageProfiler::ReadCycleCounter() - start;
+
+                if (result.has_value())
+                {
+                    sink = result->frequency;
+                }
+            }
+
+            const auto stats = StageProfiler::ComputeStatistics(callCycles);
+            const double maxMilliseconds = ToMilliseconds(static_cast<double>(stats.max), cyclesPerSecond);
+            const double budgetUse = 100.0 * maxMilliseconds / settings.budgetMilliseconds;
+            overBudget = overBudget || maxMilliseconds > settings.budgetMilliseconds;
+
+            std::printf("%-22s %-18s %10.4f %10.4f %10.4f %10.4f %7.1f%%%s\n", target.name, input.name.c_str(),
+                        ToMilliseconds(static_cast<double>(stats.p50), cyclesPerSecond),
+                        ToMilliseconds(static_cast<double>(stats.p99), cyclesPerSecond),
+                        ToMilliseconds(static_cast<double>(stats.p999), cyclesPerSecond), maxMilliseconds, budgetUse,
+                        maxMilliseconds > settings.budgetMilliseconds ? "  OVER" : "");
+
+            for (size_t stage = 0; stage < static_cast<size_t>(ProfileStage::Count); ++stage)
+            {
+                const auto profileStage = static_cast<ProfileStage>(stage);
+                const auto stageStats = profiler.ComputeStatistics(profileStage);
+                if (stageStats.count == 0)
+                {
+                    continue;
+                }
+
+                std::printf("  %-38s %10.4f %10.4f %10.4f %10.4f  n=%zu\n", StageProfiler::GetStageName(profileStage),
+                            ToMilliseconds(static_cast<double>(stageStats.p50), cyclesPerSecond),
+                            ToMilliseconds(static_cast<double>(stageStats.p99), cyclesPerSecond),
+                            ToMilliseconds(static_cast<double>(stageStats.p999), cyclesPerSecond),
+                            ToMilliseconds(static_cast<double>(stageStats.max), cyclesPerSecond), stageStats.count);
+            }
+        }
+    }
+
+    StageProfiler::SetActive(nullptr);
+    (void)sink;
+
+#if !defined(GUITAR_DSP_PROFILING)
+    std::printf("\nstage breakdown unavailable: configure with -DGUITAR_DSP_ENABLE_PROFILING=ON\n");
+#endif
+
+    std::printf("\n%s\n", overBudget ? "FAIL: worst case exceeds callback budget" : "OK: all calls within budget");
+    return overBudget ? 1 : 0;
+}